@@ -13,6 +13,13 @@ pub fn build(b: *std.build.Builder) void {
 	mt_maths.addCSourceFiles(&.{
 		"src/mtmath_c.cpp",
 		"src/impl/rational.cpp",
+		"src/impl/hybrid_rational.cpp",
+		"src/impl/super_accumulator.cpp",
+		"src/impl/dyadic.cpp",
+		"src/impl/big_float.cpp",
+		"src/impl/big_decimal.cpp",
+		"src/impl/column_store.cpp",
+		"src/impl/limbs.cpp",
 		"src/impl/big_int.cpp",
 		"src/impl/byte_array.cpp",
 	}, &.{
@@ -29,9 +36,16 @@ pub fn build(b: *std.build.Builder) void {
 	mt_maths_tests.addCSourceFiles(&.{
 		"tests/main.cpp",
 		"tests/rationals.cpp",
+		"tests/hybrid_rational.cpp",
+		"tests/super_accumulator.cpp",
+		"tests/dyadic.cpp",
+		"tests/big_float.cpp",
+		"tests/big_decimal.cpp",
+		"tests/column_store.cpp",
 		"tests/big_int.cpp",
 		"tests/byte_array.cpp",
 		"tests/c_bindings/big_int.cpp",
+		"tests/c_bindings/rational.cpp",
 	}, &.{
 		"-std=c++20",
 		"-Wall",
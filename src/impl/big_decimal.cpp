@@ -0,0 +1,193 @@
+#include "big_decimal.h"
+#include <cmath>
+
+// Largest power of ten which fits in a word, so most scaling is done with single word multiplies
+static constexpr uint64_t WORD_POW10 = 10000000000000000000ULL;
+static constexpr size_t WORD_POW10_DIGITS = 19;
+
+static uint64_t small_pow10(size_t digits) {
+  uint64_t res = 1;
+  for (size_t i = 0; i < digits; ++i) {
+    res *= 10;
+  }
+  return res;
+}
+
+// 10^digits by repeated squaring, so large powers cost a few big multiplies rather than one word multiply per 19 digits
+static mtmath::BigInt pow10(size_t digits) {
+  auto res = mtmath::BigInt::one();
+  res *= small_pow10(digits % WORD_POW10_DIGITS);
+  auto base = mtmath::BigInt::one();
+  base *= WORD_POW10;
+  for (auto words = digits / WORD_POW10_DIGITS; words; words >>= 1) {
+    if (words & 1) {
+      res *= base;
+    }
+    if (words > 1) {
+      base *= base.view();
+    }
+  }
+  return res;
+}
+
+static void multiply_pow10(mtmath::BigInt &value, size_t digits) {
+  if (digits < WORD_POW10_DIGITS) {
+    value *= small_pow10(digits);
+  }
+  else {
+    value *= pow10(digits);
+  }
+}
+
+// n / d rounded to an integer by the given mode
+static mtmath::BigInt divide_rounded(const mtmath::BigInt &n, const mtmath::BigInt &d, mtmath::BigDecimal::RoundingMode rounding) {
+  if (d.is_zero() || !n.is_valid() || !d.is_valid()) {
+    return mtmath::BigInt::invalid();
+  }
+  auto [r, q] = n.divide(d);
+  if (r.is_zero()) {
+    return q;
+  }
+  auto negative = n.is_negative() != d.is_negative();
+  // Twice the remainder against the divisor tells which side of the halfway point the quotient is on
+  auto half = (r.abs_val() << 1) <=> d.abs_val();
+  auto away = mtmath::DecimalExpansion::rounds_away(rounding, negative, q % 2 != 0, half);
+  if (away) {
+    q += negative ? -1 : 1;
+  }
+  return q;
+}
+
+mtmath::BigDecimal mtmath::BigDecimal::from_rational(const mtmath::Rational &value, int32_t scale, RoundingMode rounding) {
+  if (!value.is_finite()) {
+    return BigDecimal{mtmath::BigInt::invalid(), scale};
+  }
+  auto n = value.numerator();
+  auto d = value.denominator();
+  if (scale >= 0) {
+    multiply_pow10(n, static_cast<size_t>(scale));
+  }
+  else {
+    multiply_pow10(d, static_cast<size_t>(-static_cast<int64_t>(scale)));
+  }
+  return BigDecimal{divide_rounded(n, d, rounding), scale};
+}
+
+mtmath::BigDecimal mtmath::BigDecimal::rescale(int32_t scale, RoundingMode rounding) const {
+  if (scale >= m_scale) {
+    auto res = m_unscaled;
+    multiply_pow10(res, static_cast<size_t>(static_cast<int64_t>(scale) - m_scale));
+    return BigDecimal{std::move(res), scale};
+  }
+  return BigDecimal{divide_rounded(m_unscaled, pow10(static_cast<size_t>(static_cast<int64_t>(m_scale) - scale)), rounding), scale};
+}
+
+mtmath::BigDecimal mtmath::BigDecimal::divide(const mtmath::BigDecimal &o, int32_t scale, RoundingMode rounding) const {
+  // a * 10^-sa / (b * 10^-sb) = (a / b) * 10^(sb - sa), so shift by scale + sa - sb digits before dividing
+  auto n = m_unscaled;
+  auto d = o.m_unscaled;
+  auto shift = static_cast<int64_t>(scale) - m_scale + o.m_scale;
+  if (shift >= 0) {
+    multiply_pow10(n, static_cast<size_t>(shift));
+  }
+  else {
+    multiply_pow10(d, static_cast<size_t>(-shift));
+  }
+  return BigDecimal{divide_rounded(n, d, rounding), scale};
+}
+
+mtmath::Rational mtmath::BigDecimal::to_rational() const {
+  if (!is_valid()) {
+    return std::numeric_limits<mtmath::Rational>::quiet_NaN();
+  }
+  if (m_scale <= 0) {
+    auto n = m_unscaled;
+    multiply_pow10(n, static_cast<size_t>(-static_cast<int64_t>(m_scale)));
+    return mtmath::Rational{std::move(n)};
+  }
+  return mtmath::Rational{m_unscaled, pow10(static_cast<size_t>(m_scale))};
+}
+
+std::string mtmath::BigDecimal::to_string() const {
+  if (!is_valid()) {
+    return "NaN";
+  }
+  auto res = m_unscaled.abs_val().to_string(10).value();
+  if (m_scale < 0) {
+    if (!m_unscaled.is_zero()) {
+      res.append(static_cast<size_t>(-static_cast<int64_t>(m_scale)), '0');
+    }
+  }
+  else if (m_scale > 0) {
+    auto scale = static_cast<size_t>(m_scale);
+    if (res.size() <= scale) {
+      res.insert(0, scale + 1 - res.size(), '0');
+    }
+    res.insert(res.size() - scale, 1, '.');
+  }
+  if (m_unscaled.is_negative()) {
+    res.insert(0, 1, '-');
+  }
+  return res;
+}
+
+// Lower bound on log10 of |unscaled| * 10^-scale, which is below it by less than log10(2)
+static double magnitude_log10(const mtmath::BigInt &unscaled, int32_t scale) noexcept {
+  return static_cast<double>(unscaled.bit_length() - 1) * std::log10(2.0) - scale;
+}
+
+std::strong_ordering mtmath::BigDecimal::operator<=>(const mtmath::BigDecimal &o) const noexcept {
+  if (is_valid() && o.is_valid() && m_scale != o.m_scale) {
+    auto sign = is_zero() ? 0 : (is_negative() ? -1 : 1);
+    auto otherSign = o.is_zero() ? 0 : (o.is_negative() ? -1 : 1);
+    if (sign != otherSign || sign == 0) {
+      return sign <=> otherSign;
+    }
+    // Values more than a digit apart in size compare without rescaling, so the scale gap left is bounded by the digits
+    auto size = magnitude_log10(m_unscaled, m_scale);
+    auto otherSize = magnitude_log10(o.m_unscaled, o.m_scale);
+    if (size + 1 < otherSize) {
+      return sign > 0 ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+    if (otherSize + 1 < size) {
+      return sign > 0 ? std::strong_ordering::greater : std::strong_ordering::less;
+    }
+  }
+  if (m_scale == o.m_scale) {
+    return m_unscaled <=> o.m_unscaled;
+  }
+  else if (m_scale < o.m_scale) {
+    return rescale(o.m_scale).m_unscaled <=> o.m_unscaled;
+  }
+  return m_unscaled <=> o.rescale(m_scale).m_unscaled;
+}
+
+mtmath::BigDecimal &mtmath::BigDecimal::operator+=(const mtmath::BigDecimal &o) {
+  if (m_scale == o.m_scale) {
+    m_unscaled += o.m_unscaled;
+  }
+  else if (m_scale < o.m_scale) {
+    *this = rescale(o.m_scale);
+    m_unscaled += o.m_unscaled;
+  }
+  else {
+    m_unscaled += o.rescale(m_scale).m_unscaled;
+  }
+  return *this;
+}
+
+mtmath::BigDecimal &mtmath::BigDecimal::operator-=(const mtmath::BigDecimal &o) {
+  return *this += -o;
+}
+
+mtmath::BigDecimal &mtmath::BigDecimal::operator*=(const mtmath::BigDecimal &o) {
+  auto scale = static_cast<int64_t>(m_scale) + o.m_scale;
+  if (scale < std::numeric_limits<int32_t>::min() || scale > std::numeric_limits<int32_t>::max()) {
+    m_unscaled = mtmath::BigInt::invalid();
+    m_scale = 0;
+    return *this;
+  }
+  m_unscaled *= o.m_unscaled;
+  m_scale = static_cast<int32_t>(scale);
+  return *this;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "rational.h"
+#include <compare>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace mtmath {
+  /**
+   * Decimal number unscaled * 10^-scale. Addition and subtraction only align scales with a multiply by a
+   * power of ten, multiplication adds the scales, and only division and rescaling round, with an explicit mode.
+   * No gcd is ever needed, unlike Rational
+   */
+  class BigDecimal {
+  public:
+    /** Same modes as java.math.BigDecimal; UP and DOWN are away from and toward zero */
+    using RoundingMode = mtmath::DecimalRounding;
+
+    BigDecimal(mtmath::BigInt unscaled, int32_t scale = 0) : m_unscaled(std::move(unscaled)), m_scale(scale) {}
+    BigDecimal() = default;
+    BigDecimal(const BigDecimal& other) = default;
+    BigDecimal(BigDecimal&& other) noexcept = default;
+    BigDecimal& operator=(const BigDecimal& other) = default;
+    BigDecimal& operator=(BigDecimal&& other) noexcept = default;
+
+    /** Value rounded to the given scale. Invalid for NaN and infinities */
+    static BigDecimal from_rational(const mtmath::Rational& value, int32_t scale, RoundingMode rounding = RoundingMode::HALF_EVEN);
+
+    [[nodiscard]] const mtmath::BigInt& unscaled() const noexcept { return m_unscaled; }
+    [[nodiscard]] int32_t scale() const noexcept { return m_scale; }
+    [[nodiscard]] bool is_valid() const noexcept { return m_unscaled.is_valid(); }
+    [[nodiscard]] bool is_zero() const noexcept { return m_unscaled.is_zero(); }
+    [[nodiscard]] bool is_negative() const noexcept { return m_unscaled.is_negative(); }
+
+    /** Same value at a new scale, rounding if digits are dropped */
+    [[nodiscard]] BigDecimal rescale(int32_t scale, RoundingMode rounding = RoundingMode::HALF_EVEN) const;
+    /** this / o rounded to the given scale. Invalid when dividing by zero */
+    [[nodiscard]] BigDecimal divide(const BigDecimal& o, int32_t scale, RoundingMode rounding = RoundingMode::HALF_EVEN) const;
+
+    [[nodiscard]] mtmath::Rational to_rational() const;
+    /** Plain decimal notation keeping every digit of the scale, e.g. "-12.50". Invalid values print as NaN like BigInt */
+    [[nodiscard]] std::string to_string() const;
+
+    /** Compares values, so 1.5 and 1.50 are equal */
+    [[nodiscard]] std::strong_ordering operator<=>(const BigDecimal& o) const noexcept;
+    [[nodiscard]] bool operator==(const BigDecimal& o) const noexcept {
+      return (*this <=> o) == std::strong_ordering::equal;
+    }
+
+    BigDecimal operator-() const { return BigDecimal{-m_unscaled, m_scale}; }
+    /** Result has the larger of the two scales */
+    BigDecimal& operator+=(const BigDecimal& o);
+    BigDecimal& operator-=(const BigDecimal& o);
+    /** Result scale is the sum of the scales, so the product is exact. Invalid if that sum overflows int32_t */
+    BigDecimal& operator*=(const BigDecimal& o);
+    BigDecimal operator+(const BigDecimal& o) const { auto copy = *this; return copy += o; }
+    BigDecimal operator-(const BigDecimal& o) const { auto copy = *this; return copy -= o; }
+    BigDecimal operator*(const BigDecimal& o) const { auto copy = *this; return copy *= o; }
+
+    friend std::ostream& operator<<(std::ostream& o, const BigDecimal& d) {
+      o << d.to_string();
+      return o;
+    }
+
+  private:
+    mtmath::BigInt m_unscaled = {};
+    int32_t m_scale = 0;
+  };
+}
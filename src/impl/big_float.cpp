@@ -0,0 +1,292 @@
+#include "big_float.h"
+#include <algorithm>
+#include <cmath>
+
+// Largest x with x * x <= n, by Newton's iteration from a starting point above the root
+static mtmath::BigInt isqrt(const mtmath::BigInt &n) {
+  auto x = mtmath::BigInt::one() << ((n.bit_length() + 1) / 2);
+  while (true) {
+    auto y = (x + n / x) >> 1;
+    if (y >= x) {
+      return x;
+    }
+    x = std::move(y);
+  }
+}
+
+static int64_t top_bit(const mtmath::Dyadic &d) {
+  return static_cast<int64_t>(d.mantissa().bit_length()) + d.exponent();
+}
+
+mtmath::BigFloat::BigFloat(const mtmath::BigInt &value, size_t precision, RoundingMode rounding)
+    : m_precision(precision), m_rounding(rounding) {
+  if (!value.is_valid()) {
+    assign_special(Kind::NOT_A_NUMBER);
+    return;
+  }
+  assign_rounded(value, 0, false);
+}
+
+mtmath::BigFloat::BigFloat(const mtmath::Dyadic &value, size_t precision, RoundingMode rounding)
+    : m_precision(precision), m_rounding(rounding) {
+  if (!value.is_valid()) {
+    assign_special(Kind::NOT_A_NUMBER);
+    return;
+  }
+  assign_rounded(value.mantissa(), value.exponent(), false);
+}
+
+mtmath::BigFloat mtmath::BigFloat::from_double(double value, size_t precision, RoundingMode rounding) {
+  if (std::isnan(value)) {
+    return nan(precision);
+  }
+  else if (std::isinf(value)) {
+    return infinity(value < 0, precision);
+  }
+  return BigFloat{mtmath::Dyadic::from_double(value), precision, rounding};
+}
+
+mtmath::BigFloat mtmath::BigFloat::from_rational(const mtmath::Rational &value, size_t precision, RoundingMode rounding) {
+  if (value.is_nan()) {
+    return nan(precision);
+  }
+  else if (value.is_infinite()) {
+    return infinity(value.is_neg_infinity(), precision);
+  }
+  auto res = BigFloat{mtmath::BigInt::zero(), precision, rounding};
+  res.assign_quotient(value.numerator(), value.denominator(), 0);
+  return res;
+}
+
+mtmath::BigFloat mtmath::BigFloat::nan(size_t precision) {
+  auto res = BigFloat{};
+  res.m_precision = precision;
+  res.assign_special(Kind::NOT_A_NUMBER);
+  return res;
+}
+
+mtmath::BigFloat mtmath::BigFloat::infinity(bool negative, size_t precision) {
+  auto res = BigFloat{};
+  res.m_precision = precision;
+  res.assign_special(negative ? Kind::NEG_INFINITY : Kind::POS_INFINITY);
+  return res;
+}
+
+mtmath::BigFloat mtmath::BigFloat::with_precision(size_t precision, RoundingMode rounding) const {
+  auto res = *this;
+  res.m_precision = precision;
+  res.m_rounding = rounding;
+  if (is_finite()) {
+    res.assign_rounded(m_value.mantissa(), m_value.exponent(), false);
+  }
+  return res;
+}
+
+void mtmath::BigFloat::assign_special(Kind kind) {
+  m_kind = kind;
+  m_value = mtmath::Dyadic{};
+}
+
+void mtmath::BigFloat::assign_rounded(mtmath::BigInt mantissa, int64_t exponent, bool sticky) {
+  m_kind = Kind::FINITE;
+  auto negative = mantissa.is_negative();
+  mantissa.abs();
+  auto bits = mantissa.bit_length();
+  if (sticky && bits <= m_precision) {
+    // Make room so the sticky bits sit below the rounding position
+    auto pad = m_precision - bits + 2;
+    mantissa <<= pad;
+    exponent -= static_cast<int64_t>(pad);
+    bits += pad;
+  }
+
+  if (bits > m_precision) {
+    auto shift = bits - m_precision;
+    auto kept = mantissa >> shift;
+    auto rest = mantissa - (kept << shift);
+    auto inexact = sticky || !rest.is_zero();
+    auto up = false;
+    if (m_rounding == RoundingMode::NEAREST_EVEN) {
+      auto cmp = rest <=> (mtmath::BigInt::one() << (shift - 1));
+      up = cmp > 0 || (cmp == 0 && (sticky || kept % 2 != 0));
+    }
+    else if (m_rounding == RoundingMode::UPWARD) {
+      up = inexact && !negative;
+    }
+    else if (m_rounding == RoundingMode::DOWNWARD) {
+      up = inexact && negative;
+    }
+    if (up) {
+      // Can carry into 2^precision, which the Dyadic normalizes back down to a single bit
+      kept += 1;
+    }
+    mantissa = std::move(kept);
+    exponent += static_cast<int64_t>(shift);
+  }
+
+  if (negative) {
+    mantissa = -mantissa;
+  }
+  m_value = mtmath::Dyadic{std::move(mantissa), exponent};
+}
+
+void mtmath::BigFloat::assign_quotient(const mtmath::BigInt &numerator, const mtmath::BigInt &denominator, int64_t exponent) {
+  if (numerator.is_zero()) {
+    assign_special(Kind::FINITE);
+    return;
+  }
+  auto negative = numerator.is_negative() != denominator.is_negative();
+  auto n = numerator.abs_val();
+  auto d = denominator.abs_val();
+  // Divide only far enough for precision + 2 quotient bits, the remainder becomes the sticky bit
+  auto shift = std::max<int64_t>(0, static_cast<int64_t>(m_precision + 2 + d.bit_length()) - static_cast<int64_t>(n.bit_length()));
+  n <<= static_cast<size_t>(shift);
+  auto [r, q] = n.divide(d);
+  if (negative) {
+    q = -q;
+  }
+  assign_rounded(std::move(q), exponent - shift, !r.is_zero());
+}
+
+double mtmath::BigFloat::to_double() const noexcept {
+  if (is_nan()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  else if (is_infinite()) {
+    return is_negative() ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+  }
+  return m_value.to_double();
+}
+
+mtmath::Rational mtmath::BigFloat::to_rational() const {
+  if (is_nan()) {
+    return std::numeric_limits<mtmath::Rational>::quiet_NaN();
+  }
+  else if (is_infinite()) {
+    return is_negative() ? -std::numeric_limits<mtmath::Rational>::infinity() : std::numeric_limits<mtmath::Rational>::infinity();
+  }
+  return m_value.to_rational();
+}
+
+std::partial_ordering mtmath::BigFloat::operator<=>(const mtmath::BigFloat &o) const noexcept {
+  if (is_nan() || o.is_nan()) {
+    return std::partial_ordering::unordered;
+  }
+  auto rank = [](const BigFloat &f) { return f.is_finite() ? 0 : (f.is_negative() ? -1 : 1); };
+  if (rank(*this) != 0 || rank(o) != 0) {
+    return rank(*this) <=> rank(o);
+  }
+  return m_value <=> o.m_value;
+}
+
+mtmath::BigFloat mtmath::BigFloat::operator-() const {
+  auto res = *this;
+  if (m_kind == Kind::POS_INFINITY) {
+    res.m_kind = Kind::NEG_INFINITY;
+  }
+  else if (m_kind == Kind::NEG_INFINITY) {
+    res.m_kind = Kind::POS_INFINITY;
+  }
+  else {
+    res.m_value = -m_value;
+  }
+  return res;
+}
+
+mtmath::BigFloat &mtmath::BigFloat::operator+=(const mtmath::BigFloat &o) {
+  m_precision = std::max(m_precision, o.m_precision);
+  if (!is_finite() || !o.is_finite()) {
+    if (is_nan() || o.is_nan() || (is_infinite() && o.is_infinite() && m_kind != o.m_kind)) {
+      assign_special(Kind::NOT_A_NUMBER);
+    }
+    else if (o.is_infinite()) {
+      assign_special(o.m_kind);
+    }
+    return *this;
+  }
+  if (o.is_zero()) {
+    return *this;
+  }
+  else if (is_zero()) {
+    m_value = o.m_value;
+    return *this;
+  }
+
+  auto large = m_value;
+  auto small = o.m_value;
+  if (top_bit(large) < top_bit(small)) {
+    std::swap(large, small);
+  }
+  // An operand entirely below the rounding position only matters through its sign, so stand in a small
+  // power of two for it rather than shifting the other operand arbitrarily far
+  auto cutoff = top_bit(large) - static_cast<int64_t>(m_precision) - 3;
+  if (top_bit(small) <= cutoff) {
+    small = mtmath::Dyadic{mtmath::BigInt{small.is_negative() ? -1 : 1}, cutoff};
+  }
+  auto sum = large + small;
+  assign_rounded(sum.mantissa(), sum.exponent(), false);
+  return *this;
+}
+
+mtmath::BigFloat &mtmath::BigFloat::operator-=(const mtmath::BigFloat &o) {
+  return *this += -o;
+}
+
+mtmath::BigFloat &mtmath::BigFloat::operator*=(const mtmath::BigFloat &o) {
+  m_precision = std::max(m_precision, o.m_precision);
+  if (!is_finite() || !o.is_finite()) {
+    if (is_nan() || o.is_nan() || is_zero() || o.is_zero()) {
+      assign_special(Kind::NOT_A_NUMBER);
+    }
+    else {
+      assign_special(is_negative() != o.is_negative() ? Kind::NEG_INFINITY : Kind::POS_INFINITY);
+    }
+    return *this;
+  }
+  auto product = m_value * o.m_value;
+  assign_rounded(product.mantissa(), product.exponent(), false);
+  return *this;
+}
+
+mtmath::BigFloat &mtmath::BigFloat::operator/=(const mtmath::BigFloat &o) {
+  m_precision = std::max(m_precision, o.m_precision);
+  auto negative = is_negative() != o.is_negative();
+  if (is_nan() || o.is_nan() || (is_infinite() && o.is_infinite()) || (is_zero() && o.is_zero())) {
+    assign_special(Kind::NOT_A_NUMBER);
+  }
+  else if (is_infinite() || o.is_zero()) {
+    assign_special(negative ? Kind::NEG_INFINITY : Kind::POS_INFINITY);
+  }
+  else if (o.is_infinite()) {
+    assign_special(Kind::FINITE);
+  }
+  else {
+    auto divisor = o.m_value;
+    auto dividend = m_value;
+    assign_quotient(dividend.mantissa(), divisor.mantissa(), dividend.exponent() - divisor.exponent());
+  }
+  return *this;
+}
+
+mtmath::BigFloat mtmath::BigFloat::sqrt() const {
+  auto res = *this;
+  if (is_nan() || is_zero() || m_kind == Kind::POS_INFINITY) {
+    return res;
+  }
+  else if (is_negative()) {
+    res.assign_special(Kind::NOT_A_NUMBER);
+    return res;
+  }
+  // Scale to at least 2 * precision + 2 bits with an even exponent so the integer root has precision + 1 bits
+  auto mantissa = m_value.mantissa();
+  auto exponent = m_value.exponent();
+  auto shift = std::max<int64_t>(0, static_cast<int64_t>(2 * m_precision + 2) - static_cast<int64_t>(mantissa.bit_length()));
+  if ((exponent - shift) % 2 != 0) {
+    ++shift;
+  }
+  mantissa <<= static_cast<size_t>(shift);
+  auto root = isqrt(mantissa);
+  auto sticky = root * root != mantissa;
+  res.assign_rounded(std::move(root), (exponent - shift) / 2, sticky);
+  return res;
+}
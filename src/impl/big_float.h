@@ -0,0 +1,107 @@
+#pragma once
+
+#include "dyadic.h"
+#include <compare>
+#include <cstdint>
+#include <ostream>
+
+namespace mtmath {
+  /**
+   * Binary floating point number with a configurable precision in bits. Each operation computes just enough
+   * of the exact result to round it to precision, so sizes stay bounded instead of doubling like Rational.
+   * Values are stored as a Dyadic whose mantissa has at most precision bits.
+   * Binary operations round to the larger of the two precisions using the left operand's rounding mode
+   */
+  class BigFloat {
+  public:
+    enum class RoundingMode : uint8_t {
+      NEAREST_EVEN,
+      TOWARD_ZERO,
+      UPWARD,
+      DOWNWARD
+    };
+
+    static constexpr size_t DEFAULT_PRECISION = 256;
+
+    BigFloat(const mtmath::BigInt& value, size_t precision = DEFAULT_PRECISION, RoundingMode rounding = RoundingMode::NEAREST_EVEN);
+    BigFloat(const mtmath::Dyadic& value, size_t precision = DEFAULT_PRECISION, RoundingMode rounding = RoundingMode::NEAREST_EVEN);
+    BigFloat() = default;
+    BigFloat(const BigFloat& other) = default;
+    BigFloat(BigFloat&& other) noexcept = default;
+    BigFloat& operator=(const BigFloat& other) = default;
+    BigFloat& operator=(BigFloat&& other) noexcept = default;
+
+    static BigFloat from_double(double value, size_t precision = DEFAULT_PRECISION, RoundingMode rounding = RoundingMode::NEAREST_EVEN);
+    /** n / d rounded once, without forming the exact quotient */
+    static BigFloat from_rational(const mtmath::Rational& value, size_t precision = DEFAULT_PRECISION, RoundingMode rounding = RoundingMode::NEAREST_EVEN);
+    static BigFloat nan(size_t precision = DEFAULT_PRECISION);
+    static BigFloat infinity(bool negative = false, size_t precision = DEFAULT_PRECISION);
+
+    [[nodiscard]] size_t precision() const noexcept { return m_precision; }
+    [[nodiscard]] RoundingMode rounding() const noexcept { return m_rounding; }
+    /** Rounds to a new precision and rounding mode */
+    [[nodiscard]] BigFloat with_precision(size_t precision, RoundingMode rounding) const;
+    [[nodiscard]] BigFloat with_precision(size_t precision) const { return with_precision(precision, m_rounding); }
+
+    [[nodiscard]] bool is_nan() const noexcept { return m_kind == Kind::NOT_A_NUMBER; }
+    [[nodiscard]] bool is_infinite() const noexcept { return m_kind == Kind::POS_INFINITY || m_kind == Kind::NEG_INFINITY; }
+    [[nodiscard]] bool is_finite() const noexcept { return m_kind == Kind::FINITE; }
+    [[nodiscard]] bool is_zero() const noexcept { return is_finite() && m_value.is_zero(); }
+    [[nodiscard]] bool is_negative() const noexcept { return m_kind == Kind::NEG_INFINITY || (is_finite() && m_value.is_negative()); }
+    /** Exact value of a finite number */
+    [[nodiscard]] const mtmath::Dyadic& dyadic() const noexcept { return m_value; }
+
+    /** Nearest double (ties to even) */
+    [[nodiscard]] double to_double() const noexcept;
+    /** Exact value, NaN and infinities map to their Rational counterparts */
+    [[nodiscard]] mtmath::Rational to_rational() const;
+
+    [[nodiscard]] std::partial_ordering operator<=>(const BigFloat& o) const noexcept;
+    [[nodiscard]] bool operator==(const BigFloat& o) const noexcept {
+      return (*this <=> o) == std::partial_ordering::equivalent;
+    }
+
+    BigFloat operator-() const;
+    BigFloat& operator+=(const BigFloat& o);
+    BigFloat& operator-=(const BigFloat& o);
+    BigFloat& operator*=(const BigFloat& o);
+    BigFloat& operator/=(const BigFloat& o);
+    BigFloat operator+(const BigFloat& o) const { auto copy = *this; return copy += o; }
+    BigFloat operator-(const BigFloat& o) const { auto copy = *this; return copy -= o; }
+    BigFloat operator*(const BigFloat& o) const { auto copy = *this; return copy *= o; }
+    BigFloat operator/(const BigFloat& o) const { auto copy = *this; return copy /= o; }
+    /** Correctly rounded square root. NaN for negative numbers */
+    [[nodiscard]] BigFloat sqrt() const;
+
+    friend std::ostream& operator<<(std::ostream& o, const BigFloat& f) {
+      if (f.is_nan()) {
+        o << "nan";
+      }
+      else if (f.is_infinite()) {
+        o << (f.is_negative() ? "-inf" : "inf");
+      }
+      else {
+        o << f.m_value;
+      }
+      return o;
+    }
+
+  private:
+    enum class Kind : uint8_t {
+      FINITE,
+      POS_INFINITY,
+      NEG_INFINITY,
+      NOT_A_NUMBER
+    };
+
+    mtmath::Dyadic m_value = {};
+    size_t m_precision = DEFAULT_PRECISION;
+    RoundingMode m_rounding = RoundingMode::NEAREST_EVEN;
+    Kind m_kind = Kind::FINITE;
+
+    /** Replaces the value with mantissa * 2^exponent rounded to precision. Sticky marks non-zero bits below the mantissa */
+    void assign_rounded(mtmath::BigInt mantissa, int64_t exponent, bool sticky);
+    void assign_special(Kind kind);
+    void assign_quotient(const mtmath::BigInt& numerator, const mtmath::BigInt& denominator, int64_t exponent);
+  };
+}
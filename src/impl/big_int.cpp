@@ -1,13 +1,10 @@
 #include "big_int.h"
+#include "limbs.h"
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <utility>
 
-static char hex_char(uint8_t half_byte) {
-  if (half_byte < 10) {
-    return static_cast<char>('0' + static_cast<char>(half_byte));
-  }
-  return static_cast<char>('a' + static_cast<char>(half_byte - 10));
-}
-
 void mtmath::BigInt::simplify(){
   if (!is_valid()) {
     flags = INVALID;
@@ -15,18 +12,14 @@ void mtmath::BigInt::simplify(){
     return;
   }
 
-  for (size_t i = digits.size(); i > 0; --i) {
-    if (digits.at(i - 1) != 0) {
-      if (i != digits.size()) {
-        digits.erase(digits.begin() + static_cast<std::vector<uint8_t>::difference_type>(i), digits.end());
-      }
-      return;
-    }
+  // Trimming keeps the storage, so values which shrink and grow again do not reallocate
+  digits.simplify();
+  if (digits.empty()) {
+    flags &= ~NEGATIVE;
   }
-  digits.clear();
 }
 
-std::strong_ordering mtmath::BigInt::operator<=>(const BigInt &o) const noexcept {
+std::strong_ordering mtmath::BigInt::operator<=>(const BigIntView &o) const noexcept {
   if (!is_valid() || !o.is_valid()) {
     if (is_valid() != o.is_valid()) {
       return is_valid() ? std::strong_ordering::greater : std::strong_ordering::less;
@@ -42,7 +35,11 @@ std::strong_ordering mtmath::BigInt::operator<=>(const BigInt &o) const noexcept
     return is_negative() ? std::strong_ordering::less : std::strong_ordering::greater;
   }
   else {
-    auto cmp = abs_compare(o);
+    // Both have the same sign, for negatives the larger magnitude is the smaller number
+    auto cmp = abs_compare(o.magnitude());
+    if (is_negative()) {
+      cmp = -cmp;
+    }
     if (cmp < 0) {
       return std::strong_ordering::less;
     }
@@ -55,176 +52,189 @@ std::strong_ordering mtmath::BigInt::operator<=>(const BigInt &o) const noexcept
   }
 }
 
-std::tuple<mtmath::BigInt, mtmath::BigInt> mtmath::BigInt::divide(const BigInt &denominator) const noexcept {
+std::tuple<mtmath::BigInt, mtmath::BigInt> mtmath::BigInt::divide(const BigIntView &denominator) const noexcept {
   // Handle invalid division case
   if (!is_valid() || !(denominator.is_valid()) || denominator.is_zero()) {
     return std::make_tuple(BigInt::invalid(), BigInt::invalid());
   }
 
+  auto d = denominator.magnitude();
+  auto quotientFlags = static_cast<uint8_t>(flags ^ (denominator.is_negative() ? NEGATIVE : 0x0));
+
   // Handle trivial cases
-  auto cmp = abs_compare(denominator);
+  auto cmp = abs_compare(d);
   if (cmp < 0) {
     return std::make_tuple(*this, BigInt::zero());
   }
   else if (cmp == 0) {
     auto res = BigInt::one();
-    res.flags = flags ^ denominator.flags;
+    res.flags = quotientFlags;
     return std::make_tuple(BigInt::zero(), res);
   }
-  else if (denominator.digits == ByteArray::from<uint8_t>(0x1U)) {
+  else if (d.size() == 1 && d[0] == 1) {
     auto res = *this;
-    res.flags = flags ^ denominator.flags;
+    res.flags = quotientFlags;
     return std::make_tuple(BigInt::zero(), res);
   }
 
-  // Get a fresh, new BigInt
-  auto remainder = BigInt{};
-  auto quotient = BigInt{};
+  auto [r, q] = limbs::divide(limbs::from_bytes(digits), limbs::from_bytes(d));
+  // Truncating division, the remainder takes the sign of the numerator
+  auto remainder = BigInt{flags, limbs::to_bytes(r)};
+  auto quotient = BigInt{quotientFlags, limbs::to_bytes(q)};
+  remainder.simplify();
+  quotient.simplify();
+  return std::make_tuple(remainder, quotient);
+}
 
-  remainder.flags = flags ^ denominator.flags;
-  quotient.flags = flags ^ denominator.flags;
-  auto numBits = digits.size() * 8;
+mtmath::BigInt mtmath::BigInt::divexact(const BigIntView &denominator) const noexcept {
+  if (!is_valid() || !denominator.is_valid() || denominator.is_zero()) {
+    return BigInt::invalid();
+  }
+  auto res = BigInt{static_cast<uint8_t>(flags ^ (denominator.is_negative() ? NEGATIVE : 0x0)),
+                    limbs::to_bytes(limbs::divexact(limbs::from_bytes(digits), limbs::from_bytes(denominator.magnitude())))};
+  res.simplify();
+  return res;
+}
 
-  for (size_t i = 0; i < numBits; ++i) {
-    auto n = numBits - i - 1;
-    remainder = remainder << 1;
-    auto numeratorBit = ((digits.at(n / 8) & (0x1U << (n % 8))) >> (n % 8)) & 0x1U;
-    if (numeratorBit) {
-      if (remainder.digits.empty()) {
-        remainder.digits.emplace_back(0);
-      }
-      remainder.digits.at(0) |= 0x1;
-    }
-    if (remainder >= denominator) {
-      remainder -= denominator;
-      if (quotient.digits.size() <= n / 8) {
-        quotient.digits.resize((n / 8) + 1);
-      }
-      quotient.digits.at(n / 8) |= 0x1 << (n % 8);
-    }
+mtmath::BigInt mtmath::BigInt::gcd(const BigIntView &a, const BigIntView &b) {
+  if (!a.is_valid() || !b.is_valid()) {
+    return BigInt::invalid();
   }
+  return BigInt{0x0, limbs::to_bytes(limbs::gcd(limbs::from_bytes(a.magnitude()), limbs::from_bytes(b.magnitude())))};
+}
 
-  remainder.digits.simplify();
-  quotient.digits.simplify();
-  return std::make_tuple(remainder, quotient);
+std::tuple<mtmath::BigInt, mtmath::BigInt, mtmath::BigInt> mtmath::BigInt::gcdext(const BigInt &a, const BigInt &b) {
+  if (!a.is_valid() || !b.is_valid()) {
+    return std::make_tuple(BigInt::invalid(), BigInt::invalid(), BigInt::invalid());
+  }
+  auto [g, s, sNegative] = limbs::gcdext(limbs::from_bytes(a.digits), limbs::from_bytes(b.digits));
+  auto gcdRes = BigInt{0x0, limbs::to_bytes(g)};
+  auto sRes = BigInt{static_cast<uint8_t>((sNegative ? NEGATIVE : 0x0) ^ (a.flags & NEGATIVE)), limbs::to_bytes(s)};
+  sRes.simplify();
+  // g - s * a is an exact multiple of b
+  auto tRes = b.is_zero() ? BigInt::zero() : (gcdRes - sRes * a).divexact(b);
+  return std::make_tuple(gcdRes, sRes, tRes);
 }
 
-mtmath::BigInt& mtmath::BigInt::operator+=(const mtmath::BigInt &o) noexcept {
+mtmath::BigInt mtmath::BigInt::invmod(const BigInt &a, const BigInt &m) {
+  if (!a.is_valid() || !m.is_valid() || m.is_zero()) {
+    return BigInt::invalid();
+  }
+  auto [g, s, t] = gcdext(a, m);
+  if (g != BigInt::one()) {
+    return BigInt::invalid();
+  }
+  auto modulus = m.abs_val();
+  auto res = s % modulus;
+  if (res.is_negative()) {
+    res += modulus;
+  }
+  return res;
+}
+
+mtmath::BigInt& mtmath::BigInt::operator+=(const mtmath::BigIntView &o) noexcept {
   if (!is_valid() || !o.is_valid()) {
     flags |= INVALID;
     return *this;
   }
-  if (flags == o.flags) {
-    uint16_t buffer = 0;
-    for (size_t index = 0; index < o.digits.size() || index < digits.size(); ++index) {
-      auto left = index < digits.size() ? digits.at(index) : 0;
-      auto right = index < o.digits.size() ? o.digits.at(index) : 0;
-      buffer += left;
-      buffer += right;
-      auto digit = buffer % 256;
-      if (index < digits.size()) {
-        digits[index] = digit;
-      }
-      else {
-        digits.emplace_back(digit);
-      }
-      buffer /= 256;
-    }
-    if (buffer) {
-      auto digit = buffer % 256;
-      if (o.digits.size() < digits.size()) {
-        digits[o.digits.size()] = digit;
-      }
-      else {
-        digits.emplace_back(digit);
-      }
-    }
-    return *this;
-  }
-  else if (flags) {
-    flags ^= NEGATIVE;
-    *this -= o;
-    flags ^= NEGATIVE;
-    return *this;
+  if (is_negative() == o.is_negative()) {
+    add_magnitude(o.magnitude());
   }
   else {
-    return this->operator-=(-o);
+    sub_magnitude(o.magnitude());
   }
+  return *this;
 }
 
-mtmath::BigInt& mtmath::BigInt::operator-=(const mtmath::BigInt &o) noexcept {
+mtmath::BigInt& mtmath::BigInt::operator-=(const mtmath::BigIntView &o) noexcept {
   if (!is_valid() || !o.is_valid()) {
     flags |= INVALID;
     return *this;
   }
+  if (is_negative() == o.is_negative()) {
+    sub_magnitude(o.magnitude());
+  }
+  else {
+    add_magnitude(o.magnitude());
+  }
+  return *this;
+}
 
-  if (flags == o.flags) {
-    auto newDigits = ByteArray{};
-    newDigits.reserve(std::max(o.digits.size(), digits.size()));
-
-    bool abs_less = abs_compare(o) < 0;
-    const auto& bigger = abs_less ? o: *this;
-    const auto& smaller = abs_less ? *this : o;
-
-    int16_t borrow = 0;
-    for (size_t index = 0; index < bigger.digits.size() || index < smaller.digits.size(); ++index) {
-      auto left = static_cast<int16_t>(index < bigger.digits.size() ? bigger.digits.at(index) : 0);
-      auto right = static_cast<int16_t>(index < smaller.digits.size() ? smaller.digits.at(index) : 0);
-      auto num = left - right + borrow;
-      borrow = 0;
-      while (num < 0) {
-        borrow -= 1;
-        num += 256;
-      }
-      newDigits.emplace_back(static_cast<uint8_t>(num));
-    }
+void mtmath::BigInt::add_magnitude(std::span<const uint8_t> o) noexcept {
+  // Adding to itself never resizes, so o stays valid
+  if (o.size() > digits.size()) {
+    digits.resize(o.size());
+  }
+  if (limbs::add_bytes(digits.data(), digits.size(), o.data(), o.size())) {
+    digits.emplace_back(1);
+  }
+}
 
-    if (abs_less) {
-      flags ^= NEGATIVE;
-    }
-    std::swap(digits, newDigits);
-    simplify();
-    return *this;
+void mtmath::BigInt::sub_magnitude(std::span<const uint8_t> o) noexcept {
+  // Subtracts in place so the digits keep their storage. When o is bigger this becomes o - this
+  if (abs_compare(o) < 0) {
+    digits.resize(o.size());
+    limbs::sub_bytes(digits.data(), o.data(), o.size(), digits.data(), digits.size());
+    flags ^= NEGATIVE;
   }
   else {
-    return this->operator+=(-o);
+    limbs::sub_bytes(digits.data(), digits.data(), digits.size(), o.data(), o.size());
   }
+  simplify();
 }
 
-mtmath::BigInt& mtmath::BigInt::operator/=(const mtmath::BigInt &o) noexcept {
+mtmath::BigInt& mtmath::BigInt::operator/=(const mtmath::BigIntView &o) noexcept {
   auto [r, q] = divide(o);
   *this = std::move(q);
   return *this;
 }
 
-mtmath::BigInt& mtmath::BigInt::operator%=(const mtmath::BigInt &o) noexcept {
+mtmath::BigInt& mtmath::BigInt::operator%=(const mtmath::BigIntView &o) noexcept {
   auto [r, q] = divide(o);
   *this = std::move(r);
   return *this;
 }
 
-mtmath::BigInt& mtmath::BigInt::operator*=(const mtmath::BigInt &o) noexcept {
+mtmath::BigInt& mtmath::BigInt::operator*=(const mtmath::BigIntView &o) noexcept {
   if (!is_valid() || !(o.is_valid())) {
     flags |= INVALID;
     return *this;
   }
 
-  auto res = (to_immut() * o.to_immut()).to_mut();
-  *this = std::move(res);
+  flags = (flags ^ (o.is_negative() ? NEGATIVE : 0x0)) & NEGATIVE;
+  digits = limbs::to_bytes(limbs::mul(limbs::from_bytes(digits), limbs::from_bytes(o.magnitude())));
+  simplify();
   return *this;
 }
 
+mtmath::BigInt mtmath::BigInt::operator<<(size_t i) const {
+  // Shift straight into the result rather than copying and then shifting
+  auto res = BigInt{flags, ByteArray{}};
+  digits.shift_left_into(i, res.digits);
+  res.simplify();
+  return res;
+}
+
+mtmath::BigInt mtmath::BigInt::operator>>(size_t i) const {
+  auto res = BigInt{flags, ByteArray{}};
+  digits.shift_right_into(i, res.digits);
+  res.simplify();
+  return res;
+}
+
 mtmath::BigInt& mtmath::BigInt::operator<<=(size_t i) {
   digits <<= i;
+  simplify();
   return *this;
 }
 
 mtmath::BigInt& mtmath::BigInt::operator>>=(size_t i) {
   digits >>= i;
+  simplify();
   return *this;
 }
 
-mtmath::immut::BigInt mtmath::BigInt::to_immut() const {
+mtmath::immut::BigInt mtmath::BigInt::to_immut() const& {
   if (is_valid()) {
     return mtmath::immut::BigInt{flags, std::make_shared<ByteArray>(digits)};
   }
@@ -233,7 +243,202 @@ mtmath::immut::BigInt mtmath::BigInt::to_immut() const {
   }
 }
 
-std::optional<std::string> mtmath::BigInt::to_string(int base) const {
+mtmath::immut::BigInt mtmath::BigInt::to_immut() && {
+  if (is_valid()) {
+    return mtmath::immut::BigInt{flags, std::make_shared<ByteArray>(std::move(digits))};
+  }
+  else {
+    return mtmath::immut::BigInt{flags, nullptr};
+  }
+}
+
+static char digit_char(uint64_t digit) {
+  return digit < 10 ? static_cast<char>('0' + digit) : static_cast<char>('a' + digit - 10);
+}
+
+static uint32_t char_digit(char ch) {
+  if (ch >= '0' && ch <= '9') {
+    return static_cast<uint32_t>(ch - '0');
+  }
+  else if (ch >= 'a' && ch <= 'z') {
+    return static_cast<uint32_t>(ch - 'a' + 10);
+  }
+  else if (ch >= 'A' && ch <= 'Z') {
+    return static_cast<uint32_t>(ch - 'A' + 10);
+  }
+  return 36;
+}
+
+// Largest power of the base which fits in 32 bits, so a byte can be shifted onto any remainder in 64 bits
+static std::tuple<uint64_t, size_t> chunk_divisor(int base) {
+  uint64_t divisor = static_cast<uint64_t>(base);
+  size_t digits = 1;
+  while (divisor * static_cast<uint64_t>(base) <= std::numeric_limits<uint32_t>::max()) {
+    divisor *= static_cast<uint64_t>(base);
+    ++digits;
+  }
+  return {divisor, digits};
+}
+
+static size_t magnitude_bits(const uint8_t *bytes, size_t size) {
+  return size == 0 ? 0 : (size - 1) * 8 + static_cast<size_t>(std::bit_width(bytes[size - 1]));
+}
+
+static std::to_chars_result magnitude_to_chars(char *first, char *last, const uint8_t *bytes, size_t size, bool negative, int base) noexcept {
+  auto available = static_cast<size_t>(last - first);
+  if (size == 0) {
+    if (available < 1) {
+      return {last, std::errc::value_too_large};
+    }
+    *first = '0';
+    return {first + 1, std::errc{}};
+  }
+
+  auto out = first;
+  if (negative) {
+    if (available < 1) {
+      return {last, std::errc::value_too_large};
+    }
+    *out++ = '-';
+  }
+
+  if (std::has_single_bit(static_cast<unsigned>(base))) {
+    // Each digit is a fixed run of bits, so the length is known and digits are read straight out of the bytes
+    auto shift = static_cast<size_t>(std::countr_zero(static_cast<unsigned>(base)));
+    auto count = (magnitude_bits(bytes, size) + shift - 1) / shift;
+    if (static_cast<size_t>(last - out) < count) {
+      return {last, std::errc::value_too_large};
+    }
+    for (size_t i = 0; i < count; ++i) {
+      auto bit = i * shift;
+      auto index = bit / 8;
+      uint32_t window = bytes[index];
+      if (index + 1 < size) {
+        window |= static_cast<uint32_t>(bytes[index + 1]) << 8;
+      }
+      out[count - 1 - i] = digit_char((window >> (bit % 8)) & static_cast<uint32_t>(base - 1));
+    }
+    return {out + count, std::errc{}};
+  }
+
+  // A number has at least as many digits in any base up to 256 as it has bytes, so if the magnitude does not fit
+  // neither will the digits. It is copied most significant byte first to the back of the buffer and divided in
+  // place, while the digits are written least significant first from the front and reversed at the end
+  if (static_cast<size_t>(last - out) < size) {
+    return {last, std::errc::value_too_large};
+  }
+  auto scratch = reinterpret_cast<uint8_t *>(last) - size;
+  for (size_t i = 0; i < size; ++i) {
+    scratch[i] = bytes[size - 1 - i];
+  }
+  auto [divisor, chunkDigits] = chunk_divisor(base);
+  auto b = static_cast<uint64_t>(base);
+  size_t live = 0;
+  auto write = out;
+  while (true) {
+    uint64_t rem = 0;
+    for (size_t i = live; i < size; ++i) {
+      auto cur = (rem << 8) | scratch[i];
+      scratch[i] = static_cast<uint8_t>(cur / divisor);
+      rem = cur % divisor;
+    }
+    while (live < size && scratch[live] == 0) {
+      ++live;
+    }
+
+    if (live == size) {
+      // Last chunk, only its significant digits
+      do {
+        if (write == last) {
+          return {last, std::errc::value_too_large};
+        }
+        *write++ = digit_char(rem % b);
+        rem /= b;
+      } while (rem != 0);
+      break;
+    }
+    if (reinterpret_cast<uint8_t *>(write) + chunkDigits > scratch + live) {
+      return {last, std::errc::value_too_large};
+    }
+    for (size_t i = 0; i < chunkDigits; ++i) {
+      *write++ = digit_char(rem % b);
+      rem /= b;
+    }
+  }
+  std::reverse(out, write);
+  return {write, std::errc{}};
+}
+
+static std::to_chars_result nan_to_chars(char *first, char *last) noexcept {
+  constexpr std::string_view nan = "NaN";
+  if (static_cast<size_t>(last - first) < nan.size()) {
+    return {last, std::errc::value_too_large};
+  }
+  std::copy(nan.begin(), nan.end(), first);
+  return {first + nan.size(), std::errc{}};
+}
+
+static size_t chars_size(size_t bits, bool negative, bool valid, int base) noexcept {
+  if (!valid) {
+    return 3;
+  }
+  auto sign = negative ? 1U : 0U;
+  if (bits == 0) {
+    return 1;
+  }
+  if (std::has_single_bit(static_cast<unsigned>(base))) {
+    auto shift = static_cast<size_t>(std::countr_zero(static_cast<unsigned>(base)));
+    return sign + (bits + shift - 1) / shift;
+  }
+  // Value is below 2^bits, so it has at most floor(bits / log2(base)) + 1 digits. The slack covers rounding
+  return sign + static_cast<size_t>(static_cast<double>(bits) / std::log2(static_cast<double>(base)) + 1e-9) + 1;
+}
+
+std::to_chars_result mtmath::to_chars(char *first, char *last, const mtmath::BigInt &value, int base) noexcept {
+  if (base < 2 || base > 36) {
+    return {first, std::errc::invalid_argument};
+  }
+  if (!value.is_valid()) {
+    return nan_to_chars(first, last);
+  }
+  return magnitude_to_chars(first, last, value.digits.data(), value.digits.size(), value.is_negative(), base);
+}
+
+std::to_chars_result mtmath::to_chars(char *first, char *last, const mtmath::immut::BigInt &value, int base) noexcept {
+  if (base < 2 || base > 36) {
+    return {first, std::errc::invalid_argument};
+  }
+  if (!value.is_valid()) {
+    return nan_to_chars(first, last);
+  }
+  return magnitude_to_chars(first, last, value.digits->data(), value.digits->size(), value.is_negative(), base);
+}
+
+std::to_chars_result mtmath::to_chars(char *first, char *last, const mtmath::BigIntView &value, int base) noexcept {
+  if (base < 2 || base > 36) {
+    return {first, std::errc::invalid_argument};
+  }
+  if (!value.is_valid()) {
+    return nan_to_chars(first, last);
+  }
+  auto magnitude = value.magnitude();
+  return magnitude_to_chars(first, last, magnitude.data(), magnitude.size(), value.is_negative(), base);
+}
+
+size_t mtmath::to_chars_size(const mtmath::BigInt &value, int base) noexcept {
+  return chars_size(value.bit_length(), value.is_negative(), value.is_valid(), base);
+}
+
+size_t mtmath::to_chars_size(const mtmath::immut::BigInt &value, int base) noexcept {
+  return chars_size(value.bit_length(), value.is_negative(), value.is_valid(), base);
+}
+
+size_t mtmath::to_chars_size(const mtmath::BigIntView &value, int base) noexcept {
+  auto magnitude = value.magnitude();
+  return chars_size(magnitude_bits(magnitude.data(), magnitude.size()), value.is_negative(), value.is_valid(), base);
+}
+
+std::optional<std::string> mtmath::BigIntView::to_string(int base) const {
   if (base < 2 || base > 32) {
     return std::nullopt;
   }
@@ -246,7 +451,204 @@ std::optional<std::string> mtmath::BigInt::to_string(int base) const {
     return base == 16 ? std::optional{std::string{"0x0"}} : std::optional{std::string{"0"}};
   }
 
-  return to_immut().to_string(base);
+  std::string str(to_chars_size(*this, base), '\0');
+  auto [end, ec] = to_chars(str.data(), str.data() + str.size(), *this, base);
+  str.resize(static_cast<size_t>(end - str.data()));
+  if (base == 16) {
+    str.insert(is_negative() ? 1 : 0, "0x");
+  }
+  return str;
+}
+
+std::from_chars_result mtmath::from_chars(const char *first, const char *last, mtmath::BigInt &value, int base) {
+  if (base < 2 || base > 36) {
+    return {first, std::errc::invalid_argument};
+  }
+  auto pos = first;
+  auto negative = pos != last && *pos == '-';
+  if (negative) {
+    ++pos;
+  }
+  auto start = pos;
+  while (pos != last && char_digit(*pos) < static_cast<uint32_t>(base)) {
+    ++pos;
+  }
+  if (pos == start) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  auto count = static_cast<size_t>(pos - start);
+  value.flags = negative ? mtmath::BigInt::NEGATIVE : 0;
+  auto &digits = value.digits;
+  if (std::has_single_bit(static_cast<unsigned>(base))) {
+    // Each digit lands on a fixed run of bits
+    auto shift = static_cast<size_t>(std::countr_zero(static_cast<unsigned>(base)));
+    digits.clear();
+    digits.resize((count * shift + 7) / 8);
+    auto bytes = digits.data();
+    for (size_t i = 0; i < count; ++i) {
+      auto bit = i * shift;
+      auto digit = static_cast<uint32_t>(char_digit(pos[-1 - static_cast<std::ptrdiff_t>(i)])) << (bit % 8);
+      bytes[bit / 8] |= static_cast<uint8_t>(digit);
+      if (digit > 0xff) {
+        bytes[bit / 8 + 1] |= static_cast<uint8_t>(digit >> 8);
+      }
+    }
+  }
+  else {
+    // Multiply-add a chunk of digits at a time into bytes sized for the most the digits could need
+    auto [divisor, chunkDigits] = chunk_divisor(base);
+    auto b = static_cast<uint64_t>(base);
+    digits.resize(static_cast<size_t>(static_cast<double>(count) * std::log2(static_cast<double>(base)) / 8) + 2);
+    auto bytes = digits.data();
+    size_t used = 0;
+    for (auto chunk = start; chunk != pos;) {
+      auto chunkEnd = chunk + static_cast<std::ptrdiff_t>(std::min(chunkDigits, static_cast<size_t>(pos - chunk)));
+      uint64_t multiplier = 1;
+      uint64_t carry = 0;
+      for (; chunk != chunkEnd; ++chunk) {
+        multiplier *= b;
+        carry = carry * b + char_digit(*chunk);
+      }
+      for (size_t i = 0; i < used; ++i) {
+        auto cur = bytes[i] * multiplier + carry;
+        bytes[i] = static_cast<uint8_t>(cur);
+        carry = cur >> 8;
+      }
+      for (; carry != 0; carry >>= 8) {
+        bytes[used++] = static_cast<uint8_t>(carry);
+      }
+    }
+    digits.resize(used);
+  }
+  value.simplify();
+  return {pos, std::errc{}};
+}
+
+std::from_chars_result mtmath::from_chars(const char *first, const char *last, mtmath::immut::BigInt &value, int base) {
+  auto parsed = mtmath::BigInt{};
+  auto res = from_chars(first, last, parsed, base);
+  if (res.ec == std::errc{}) {
+    value = parsed.to_immut();
+  }
+  return res;
+}
+
+// Upper six bits of the first byte, the lower two hold the NEGATIVE and INVALID flags
+static constexpr uint8_t SERIAL_VERSION = 1;
+
+static size_t varint_size(size_t value) {
+  size_t size = 1;
+  for (; value >= 0x80; value >>= 7) {
+    ++size;
+  }
+  return size;
+}
+
+static size_t serialized_size(size_t magnitudeSize) {
+  return 1 + varint_size(magnitudeSize) + magnitudeSize;
+}
+
+static size_t serialize(std::span<std::byte> out, uint8_t flags, const uint8_t *bytes, size_t size) noexcept {
+  auto total = serialized_size(size);
+  if (out.size() < total) {
+    return 0;
+  }
+  auto pos = out.data();
+  *pos++ = static_cast<std::byte>((SERIAL_VERSION << 2) | (flags & 0x3));
+  auto remaining = size;
+  do {
+    auto low = static_cast<uint8_t>(remaining & 0x7f);
+    remaining >>= 7;
+    *pos++ = static_cast<std::byte>(remaining ? low | 0x80 : low);
+  } while (remaining);
+  if (size) {
+    std::memcpy(pos, bytes, size);
+  }
+  return total;
+}
+
+std::optional<mtmath::BigIntView> mtmath::BigIntView::deserialize(std::span<const std::byte> in, size_t *consumed) noexcept {
+  if (in.empty()) {
+    return std::nullopt;
+  }
+  auto header = std::to_integer<uint8_t>(in[0]);
+  if ((header >> 2) != SERIAL_VERSION) {
+    return std::nullopt;
+  }
+  auto negative = (header & 0x1) != 0;
+  auto invalid = (header & 0x2) != 0;
+
+  size_t size = 0;
+  size_t pos = 1;
+  for (size_t shift = 0;; shift += 7) {
+    if (pos == in.size() || shift >= std::numeric_limits<size_t>::digits) {
+      return std::nullopt;
+    }
+    auto byte = std::to_integer<uint8_t>(in[pos++]);
+    auto payload = static_cast<size_t>(byte & 0x7f);
+    // Only the shortest encoding of a size_t is canonical: no zero final group and no bits past the top
+    if (shift && (byte == 0 || (payload >> (std::numeric_limits<size_t>::digits - shift)))) {
+      return std::nullopt;
+    }
+    size |= payload << shift;
+    if (!(byte & 0x80)) {
+      break;
+    }
+  }
+  if (in.size() - pos < size) {
+    return std::nullopt;
+  }
+
+  auto magnitude = std::span<const uint8_t>{reinterpret_cast<const uint8_t *>(in.data() + pos), size};
+  // Only the form serialize writes is accepted, so views never need normalizing
+  if ((size && magnitude[size - 1] == 0) || (negative && size == 0) || (invalid && (negative || size))) {
+    return std::nullopt;
+  }
+  if (consumed) {
+    *consumed = pos + size;
+  }
+  return BigIntView{magnitude, negative, !invalid};
+}
+
+mtmath::BigInt::BigInt(const mtmath::BigIntView &view)
+    : flags(static_cast<uint8_t>((view.is_negative() ? NEGATIVE : 0) | (view.is_valid() ? 0 : INVALID))),
+      digits(std::vector<uint8_t>{view.magnitude().begin(), view.magnitude().end()}) {}
+
+size_t mtmath::BigInt::serialized_size() const noexcept {
+  return ::serialized_size(digits.size());
+}
+
+size_t mtmath::BigInt::serialize(std::span<std::byte> out) const noexcept {
+  return ::serialize(out, flags, digits.data(), digits.size());
+}
+
+std::optional<mtmath::BigInt> mtmath::BigInt::deserialize(std::span<const std::byte> in, size_t *consumed) {
+  auto view = BigIntView::deserialize(in, consumed);
+  if (!view) {
+    return std::nullopt;
+  }
+  return BigInt{*view};
+}
+
+mtmath::immut::BigInt::BigInt(const mtmath::BigIntView &view)
+    : flags(static_cast<uint8_t>((view.is_negative() ? NEGATIVE : 0) | (view.is_valid() ? 0 : INVALID))),
+      digits(std::make_shared<ByteArray>(std::vector<uint8_t>{view.magnitude().begin(), view.magnitude().end()})) {}
+
+size_t mtmath::immut::BigInt::serialized_size() const noexcept {
+  return ::serialized_size(digits->size());
+}
+
+size_t mtmath::immut::BigInt::serialize(std::span<std::byte> out) const noexcept {
+  return ::serialize(out, flags, digits->data(), digits->size());
+}
+
+std::optional<mtmath::immut::BigInt> mtmath::immut::BigInt::deserialize(std::span<const std::byte> in, size_t *consumed) {
+  auto view = BigIntView::deserialize(in, consumed);
+  if (!view) {
+    return std::nullopt;
+  }
+  return BigInt{*view};
 }
 
 mtmath::BigInt mtmath::BigInt::operator-() const {
@@ -294,25 +696,17 @@ void mtmath::BigInt::compress(int base) {
 
   simplify();
 }
-int mtmath::BigInt::abs_compare(const mtmath::BigInt &o) const noexcept {
-  if (digits.size() != o.digits.size()) {
-    return digits.size() > o.digits.size() ? 1 : -1;
-  }
-  else {
-    for (size_t i = 0; i < digits.size(); ++i) {
-      auto index = digits.size() - i - 1;
-      if (digits.at(index) != o.digits.at(index)) {
-        return digits.at(index) < o.digits.at(index) ? -1 : 1;
-      }
-    }
+int mtmath::BigInt::abs_compare(std::span<const uint8_t> o) const noexcept {
+  if (digits.size() != o.size()) {
+    return digits.size() > o.size() ? 1 : -1;
   }
-  return 0;
+  return limbs::compare_bytes(digits.data(), o.data(), o.size());
 }
 
-mtmath::immut::BigInt mtmath::immut::BigInt::zeroConst = mtmath::immut::BigInt{};
-mtmath::immut::BigInt mtmath::immut::BigInt::oneConst = mtmath::immut::BigInt{1};
-mtmath::immut::BigInt mtmath::immut::BigInt::twoConst = mtmath::immut::BigInt{2};
-mtmath::immut::BigInt mtmath::immut::BigInt::invalidConst = mtmath::immut::BigInt{INVALID, nullptr};
+mtmath::immut::BigInt mtmath::immut::BigInt::zeroConst = mtmath::immut::BigInt{ConstantTag{}, 0x0, std::make_shared<ByteArray>()};
+mtmath::immut::BigInt mtmath::immut::BigInt::oneConst = mtmath::immut::BigInt{ConstantTag{}, 0x0, std::make_shared<ByteArray>(std::vector<uint8_t>{1})};
+mtmath::immut::BigInt mtmath::immut::BigInt::twoConst = mtmath::immut::BigInt{ConstantTag{}, 0x0, std::make_shared<ByteArray>(std::vector<uint8_t>{2})};
+mtmath::immut::BigInt mtmath::immut::BigInt::invalidConst = mtmath::immut::BigInt{ConstantTag{}, INVALID, nullptr};
 
 mtmath::immut::BigInt::BigInt() { *this = zeroConst; }
 mtmath::immut::BigInt::BigInt(const mtmath::immut::BigInt &other) = default;
@@ -320,56 +714,14 @@ mtmath::immut::BigInt::BigInt(mtmath::immut::BigInt &&other) noexcept : flags(ot
 mtmath::immut::BigInt::BigInt(uint8_t flags, std::shared_ptr<ByteArray> digits) : flags(flags), digits(std::move(digits)) {simplify();}
 
 std::optional<std::string> mtmath::immut::BigInt::to_string(int base) const {
-  if (base < 2 || base > 32) {
-    return std::nullopt;
-  }
+  return view().to_string(base);
+}
 
+mtmath::BigIntView mtmath::immut::BigInt::view() const noexcept {
   if (!is_valid()) {
-    return std::optional{std::string{"NaN"}};
-  }
-
-  if (is_zero()) {
-    return base == 16 ? std::optional{std::string{"0x0"}} : std::optional{std::string{"0"}};
+    return BigIntView{{}, false, false};
   }
-
-  std::string str{};
-  if (base == 16) {
-    str.reserve((digits->size() * 2) + (is_negative() ? 1 : 0));
-
-    for (auto d: *digits) {
-      uint8_t char1 = d & 0x0f;
-      uint8_t char2 = (d & 0xf0) >> 4;
-      str.push_back(hex_char(char1));
-      str.push_back(hex_char(char2));
-    }
-    if (str[str.size() - 1] == '0') {
-      str.erase(str.begin() + static_cast<decltype(str)::difference_type>(str.size()) - 1);
-    }
-    str.push_back('x');
-    str.push_back('0');
-    if (is_negative()) {
-      str.push_back('-');
-    }
-    std::reverse(str.begin(), str.end());
-  }
-  else {
-    auto baseInt = mtmath::BigInt{base};
-    str.reserve((digits->size()) + (is_negative() ? 1 : 0));
-    auto cpy = abs_val().to_mut();
-    while (!cpy.is_zero()) {
-      auto [r, q] = cpy.divide(baseInt);
-      auto digit = r.digits.as<uint8_t>();
-      str.push_back(hex_char(digit));
-      std::swap(cpy, q);
-    }
-    if (is_negative()) {
-      str.push_back('-');
-    }
-    std::reverse(str.begin(), str.end());
-  }
-
-  str.shrink_to_fit();
-  return str;
+  return BigIntView{std::span{digits->data(), digits->size()}, is_negative()};
 }
 
 void mtmath::immut::BigInt::simplify(){
@@ -378,26 +730,21 @@ void mtmath::immut::BigInt::simplify(){
     return;
   }
 
-  for (size_t i = digits->size(); i > 0; --i) {
-    if (digits->at(i - 1) != 0) {
-      if (i != digits->size()) {
-        digits->erase(digits->begin() + static_cast<std::vector<uint8_t>::difference_type>(i), digits->end());
-      }
-      if (digits->size() == 1) {
-        auto flgs = flags;
-        if (digits->at(0) == 1) {
-          *this = oneConst;
-          flags = flgs;
-        }
-        else if (digits->at(0) == 2) {
-          *this = twoConst;
-          flags = flgs;
-        }
-      }
-      return;
+  digits->simplify();
+  if (digits->empty()) {
+    *this = zeroConst;
+  }
+  else if (digits->size() == 1) {
+    auto flgs = flags;
+    if ((*digits)[0] == 1) {
+      *this = oneConst;
+      flags = flgs;
+    }
+    else if ((*digits)[0] == 2) {
+      *this = twoConst;
+      flags = flgs;
     }
   }
-  *this = zeroConst;
 }
 
 mtmath::immut::BigInt mtmath::immut::BigInt::operator-() const {
@@ -419,19 +766,14 @@ mtmath::immut::BigInt mtmath::immut::BigInt::operator+(const mtmath::immut::BigI
     return r;
   }
   if (flags == o.flags) {
+    const auto& bigger = digits->size() >= o.digits->size() ? *digits : *o.digits;
+    const auto& smaller = digits->size() >= o.digits->size() ? *o.digits : *digits;
     auto newDigits = std::make_shared<ByteArray>();
-    newDigits->reserve(std::max(o.digits->size(), digits->size()) + 1);
-    uint16_t buffer = 0;
-    for (size_t index = 0; index < o.digits->size() || index < digits->size(); ++index) {
-      auto left = index < digits->size() ? digits->at(index) : 0;
-      auto right = index < o.digits->size() ? o.digits->at(index) : 0;
-      buffer += left;
-      buffer += right;
-      newDigits->emplace_back(buffer % 256);
-      buffer /= 256;
-    }
-    if (buffer) {
-      newDigits->emplace_back(buffer);
+    newDigits->reserve(bigger.size() + 1);
+    newDigits->resize(bigger.size());
+    std::copy(bigger.begin(), bigger.end(), newDigits->begin());
+    if (limbs::add_bytes(newDigits->data(), newDigits->size(), smaller.data(), smaller.size())) {
+      newDigits->emplace_back(1);
     }
     auto res = BigInt{flags, newDigits};
     res.simplify();
@@ -453,25 +795,13 @@ mtmath::immut::BigInt mtmath::immut::BigInt::operator-(const mtmath::immut::BigI
   }
 
   if (flags == o.flags) {
-    auto newDigits = std::make_shared<ByteArray>();
-    newDigits->reserve(std::max(o.digits->size(), digits->size()));
-
     bool abs_less = this->abs_less_than(o);
-    const auto& bigger = abs_less ? o: *this;
-    const auto& smaller = abs_less ? *this : o;
-
-    int16_t borrow = 0;
-    for (size_t index = 0; index < bigger.digits->size() || index < smaller.digits->size(); ++index) {
-      auto left = static_cast<int16_t>(index < bigger.digits->size() ? bigger.digits->at(index) : 0);
-      auto right = static_cast<int16_t>(index < smaller.digits->size() ? smaller.digits->at(index) : 0);
-      auto num = left - right + borrow;
-      borrow = 0;
-      while (num < 0) {
-        borrow -= 1;
-        num += 256;
-      }
-      newDigits->emplace_back(static_cast<uint8_t>(num));
-    }
+    const auto& bigger = abs_less ? *o.digits : *digits;
+    const auto& smaller = abs_less ? *digits : *o.digits;
+
+    auto newDigits = std::make_shared<ByteArray>();
+    newDigits->resize(bigger.size());
+    limbs::sub_bytes(newDigits->data(), bigger.data(), bigger.size(), smaller.data(), smaller.size());
 
     auto res = BigInt{static_cast<uint8_t>(abs_less ? flags ^ NEGATIVE : flags), newDigits};
     res.simplify();
@@ -498,12 +828,7 @@ bool mtmath::immut::BigInt::abs_less_than(const mtmath::immut::BigInt &o) const
   if (digits->size() != o.digits->size()) {
     return digits->size() < o.digits->size();
   }
-  for (size_t i = digits->size(); i > 0; --i) {
-    if (digits->at(i - 1) != o.digits->at(i - 1)) {
-      return digits->at(i - 1) < o.digits->at(i - 1);
-    }
-  }
-  return false;
+  return limbs::compare_bytes(digits->data(), o.digits->data(), digits->size()) < 0;
 }
 
 mtmath::immut::BigInt mtmath::immut::BigInt::operator/(const mtmath::immut::BigInt &denominator) const noexcept {
@@ -527,38 +852,33 @@ mtmath::immut::BigInt mtmath::immut::BigInt::operator*(const mtmath::immut::BigI
     return zero();
   }
 
-  auto result = BigInt::fresh();
-
-  result.flags = flags ^ o.flags;
-
-  // TODO: Adjust to use Karatsuba for very big integers
+  auto product = limbs::mul(limbs::from_bytes(*digits), limbs::from_bytes(*o.digits));
+  return BigInt{static_cast<uint8_t>(flags ^ o.flags), std::make_shared<ByteArray>(limbs::to_bytes(product))};
+}
 
-  for (size_t m = 0; m < digits->size(); ++m) {
-    uint32_t carryOver = 0;
-    for (size_t n = 0; n < o.digits->size(); ++n) {
-      auto resIndex = m + n;
-      auto res = static_cast<uint32_t>(digits->at(m)) * static_cast<uint32_t>(o.digits->at(n)) + carryOver;
-      if (resIndex < result.digits->size()) {
-        result.digits->at(resIndex) += res % 256;
-      }
-      else {
-        result.digits->emplace_back(res % 256);
-      }
-      carryOver = res / 256;
-    }
+mtmath::immut::BigInt mtmath::immut::BigInt::divexact(const BigInt &denominator) const noexcept {
+  if (!is_valid() || !denominator.is_valid() || denominator.is_zero()) {
+    return invalidConst;
+  }
+  auto res = limbs::divexact(limbs::from_bytes(*digits), limbs::from_bytes(*denominator.digits));
+  return BigInt{static_cast<uint8_t>(flags ^ denominator.flags), std::make_shared<ByteArray>(limbs::to_bytes(res))};
+}
 
-    if (carryOver) {
-      auto resIndex = m + o.digits->size();
-      if (resIndex < result.digits->size()) {
-        result.digits->at(resIndex) += carryOver;
-      } else {
-        result.digits->emplace_back(carryOver);
-      }
-    }
+mtmath::immut::BigInt mtmath::immut::BigInt::gcd(const BigInt &a, const BigInt &b) {
+  if (!a.is_valid() || !b.is_valid()) {
+    return invalidConst;
   }
+  auto res = limbs::gcd(limbs::from_bytes(*a.digits), limbs::from_bytes(*b.digits));
+  return BigInt{0x0, std::make_shared<ByteArray>(limbs::to_bytes(res))};
+}
 
-  result.simplify();
-  return result;
+std::tuple<mtmath::immut::BigInt, mtmath::immut::BigInt, mtmath::immut::BigInt> mtmath::immut::BigInt::gcdext(const BigInt &a, const BigInt &b) {
+  auto [g, s, t] = mtmath::BigInt::gcdext(a.to_mut(), b.to_mut());
+  return std::make_tuple(g.to_immut(), s.to_immut(), t.to_immut());
+}
+
+mtmath::immut::BigInt mtmath::immut::BigInt::invmod(const BigInt &a, const BigInt &m) {
+  return mtmath::BigInt::invmod(a.to_mut(), m.to_mut()).to_immut();
 }
 
 void mtmath::immut::BigInt::compress(int base) {
@@ -610,21 +930,17 @@ std::strong_ordering mtmath::immut::BigInt::operator<=>(const mtmath::immut::Big
   else if (is_negative() != o.is_negative()) {
     return is_negative() ? std::strong_ordering::less : std::strong_ordering::greater;
   }
+  else if (is_negative()) {
+    // For negatives the larger magnitude is the smaller number
+    return o.abs() <=> abs();
+  }
   else if (digits == o.digits) {
     return std::strong_ordering::equal;
   }
   else if (digits->size() != o.digits->size()) {
     return digits->size() > o.digits->size() ? std::strong_ordering::greater : std::strong_ordering::less;
   }
-  else {
-    for (size_t i = 0; i < digits->size(); ++i) {
-      auto index = digits->size() - i - 1;
-      if (digits->at(index) != o.digits->at(index)) {
-        return digits->at(index) < o.digits->at(index) ? std::strong_ordering::less : std::strong_ordering::greater;
-      }
-    }
-  }
-  return std::strong_ordering::equal;
+  return limbs::compare_bytes(digits->data(), o.digits->data(), digits->size()) <=> 0;
 }
 
 bool mtmath::immut::BigInt::is_zero() const noexcept {
@@ -673,15 +989,11 @@ std::tuple<mtmath::immut::BigInt, mtmath::immut::BigInt> mtmath::immut::BigInt::
 }
 
 mtmath::immut::BigInt mtmath::immut::BigInt::operator<<(size_t i) const noexcept {
-  mtmath::immut::BigInt res;
-  res.digits = std::make_shared<ByteArray>(digits->operator<<(i));
-  return res;
+  return mtmath::immut::BigInt{flags, std::make_shared<ByteArray>(digits->operator<<(i))};
 }
 
 mtmath::immut::BigInt mtmath::immut::BigInt::operator>>(size_t i) const noexcept {
-  mtmath::immut::BigInt res;
-  res.digits = std::make_shared<ByteArray>(digits->operator>>(i));
-  return res;
+  return mtmath::immut::BigInt{flags, std::make_shared<ByteArray>(digits->operator>>(i))};
 }
 
 mtmath::BigInt mtmath::immut::BigInt::to_mut() const {
@@ -697,14 +1009,27 @@ void mtmath::c::into(const mtmath::BigInt& bi, MtMath_BigInt* out) {
   free(out->digits.bytes);
   out->digits.len = bi.digits.size();
   out->digits.bytes = static_cast<uint8_t *>(malloc(sizeof(uint8_t) * out->digits.len));
-  memcpy(out->digits.bytes, std::addressof(bi.digits[0]), out->digits.len);
+  if (out->digits.len) {
+    memcpy(out->digits.bytes, bi.digits.data(), out->digits.len);
+  }
   out->flags = bi.flags;
 }
 
 void mtmath::c::into(const MtMath_BigInt& cbi, mtmath::BigInt* out) {
   out->flags = cbi.flags;
   out->digits.resize(cbi.digits.len);
-  memcpy(std::addressof(out->digits[0]), cbi.digits.bytes, cbi.digits.len);
+  if (cbi.digits.len) {
+    memcpy(out->digits.data(), cbi.digits.bytes, cbi.digits.len);
+  }
+}
+
+mtmath::BigIntView mtmath::c::view(const MtMath_BigInt& cbi) noexcept {
+  auto size = cbi.digits.bytes ? static_cast<size_t>(cbi.digits.len) : 0;
+  while (size > 0 && cbi.digits.bytes[size - 1] == 0) {
+    --size;
+  }
+  return BigIntView{std::span<const uint8_t>{cbi.digits.bytes, size}, (cbi.flags & BigInt::NEGATIVE) != 0,
+                    (cbi.flags & BigInt::INVALID) == 0};
 }
 
 int64_t mtmath::BigInt::as_i64() const noexcept {
@@ -715,6 +1040,362 @@ int64_t mtmath::BigInt::as_i64() const noexcept {
   return val;
 }
 
+// Mantissa of the leading (up to 8) bytes, which is all a double can hold anyway
+static double leading_mantissa(const mtmath::ByteArray &digits, bool negative, size_t bitLength, int64_t &exponent) {
+  if (digits.empty()) {
+    exponent = 0;
+    return 0.0;
+  }
+  auto count = std::min<size_t>(digits.size(), sizeof(uint64_t));
+  uint64_t top = 0;
+  for (size_t i = 0; i < count; ++i) {
+    top = (top << 8) | digits[digits.size() - 1 - i];
+  }
+  exponent = static_cast<int64_t>(bitLength);
+  auto mantissa = std::ldexp(static_cast<double>(top), -std::bit_width(top));
+  // Rounding the leading bits up can reach 1.0
+  if (mantissa >= 1.0) {
+    mantissa /= 2;
+    exponent += 1;
+  }
+  return negative ? -mantissa : mantissa;
+}
+
+double mtmath::BigInt::frexp(int64_t &exponent) const noexcept {
+  return leading_mantissa(digits, is_negative(), bit_length(), exponent);
+}
+
+// Leading 64 bits of the magnitude with the top bit set. Sticky is set when any lower bit is non-zero
+static uint64_t leading_word(const mtmath::ByteArray &digits, size_t bitLength, bool &sticky) {
+  auto count = std::min<size_t>(digits.size(), sizeof(uint64_t) + 1);
+  unsigned __int128 top = 0;
+  for (size_t i = 0; i < count; ++i) {
+    top = (top << 8) | digits[digits.size() - 1 - i];
+  }
+  auto topBits = bitLength - (digits.size() - count) * 8;
+  sticky = false;
+  for (size_t i = digits.size() - count; i > 0 && !sticky; --i) {
+    sticky = digits[i - 1] != 0;
+  }
+  if (topBits > 64) {
+    auto dropped = topBits - 64;
+    sticky = sticky || (top & ((static_cast<unsigned __int128>(1) << dropped) - 1)) != 0;
+    return static_cast<uint64_t>(top >> dropped);
+  }
+  return static_cast<uint64_t>(top << (64 - topBits));
+}
+
+// Rounds (top + fraction) * 2^exponent to nearest, ties to even, where top has its high bit set and sticky
+// says whether the fraction is non-zero. Handles overflow and the reduced precision of subnormals
+static double round_to_double(uint64_t top, bool sticky, int64_t exponent) {
+  auto lead = exponent + 63;
+  if (lead > std::numeric_limits<double>::max_exponent - 1) {
+    return std::numeric_limits<double>::infinity();
+  }
+  int64_t drop = 64 - std::numeric_limits<double>::digits;
+  if (lead < std::numeric_limits<double>::min_exponent - 1) {
+    drop += std::numeric_limits<double>::min_exponent - 1 - lead;
+  }
+  if (drop > 64) {
+    return 0.0;
+  }
+  uint64_t kept = 0;
+  uint64_t rest = top;
+  uint64_t half = uint64_t{1} << 63;
+  if (drop < 64) {
+    kept = top >> drop;
+    rest = top & ((uint64_t{1} << drop) - 1);
+    half = uint64_t{1} << (drop - 1);
+  }
+  if (rest > half || (rest == half && (sticky || (kept & 1) != 0))) {
+    ++kept;
+  }
+  // kept has at most 54 bits, so both the conversion and the scaling are exact
+  return std::ldexp(static_cast<double>(kept), static_cast<int>(exponent + drop));
+}
+
+static double magnitude_to_double(const mtmath::ByteArray &digits, bool negative, size_t bitLength, int64_t scale) {
+  if (digits.empty()) {
+    return 0.0;
+  }
+  bool sticky = false;
+  auto top = leading_word(digits, bitLength, sticky);
+  auto res = round_to_double(top, sticky, static_cast<int64_t>(bitLength) - 64 + scale);
+  return negative ? -res : res;
+}
+
+double mtmath::BigInt::to_double(int64_t scale) const noexcept {
+  if (!is_valid()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return magnitude_to_double(digits, is_negative(), bit_length(), scale);
+}
+
+mtmath::BigInt mtmath::BigInt::from_double(double value) {
+  if (!std::isfinite(value)) {
+    return BigInt::invalid();
+  }
+  auto [negative, mantissa, exponent] = split_double(value);
+  BigInt res;
+  if (exponent >= 0) {
+    res = BigInt{mantissa};
+    res <<= static_cast<size_t>(exponent);
+  }
+  else if (exponent > -64) {
+    res = BigInt{mantissa >> -exponent};
+  }
+  return negative ? -res : res;
+}
+
+static size_t magnitude_words(std::span<const uint8_t> magnitude) noexcept {
+  return (magnitude.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+}
+
+// Little-endian word i of a magnitude, zero past the end
+static uint64_t magnitude_word(std::span<const uint8_t> magnitude, size_t i) noexcept {
+  auto start = i * sizeof(uint64_t);
+  if (start >= magnitude.size()) {
+    return 0;
+  }
+  auto count = std::min(sizeof(uint64_t), magnitude.size() - start);
+  uint64_t word = 0;
+  if constexpr (std::endian::native == std::endian::little) {
+    memcpy(&word, magnitude.data() + start, count);
+  }
+  else {
+    for (size_t j = 0; j < count; ++j) {
+      word |= static_cast<uint64_t>(magnitude[start + j]) << (8 * j);
+    }
+  }
+  return word;
+}
+
+static size_t trailing_zero_bits(std::span<const uint8_t> magnitude) noexcept {
+  for (size_t i = 0; i < magnitude_words(magnitude); ++i) {
+    if (auto word = magnitude_word(magnitude, i)) {
+      return i * 64 + static_cast<size_t>(std::countr_zero(word));
+    }
+  }
+  return 0;
+}
+
+static size_t popcount_bits(std::span<const uint8_t> magnitude) noexcept {
+  size_t count = 0;
+  for (size_t i = 0; i < magnitude_words(magnitude); ++i) {
+    count += static_cast<size_t>(std::popcount(magnitude_word(magnitude, i)));
+  }
+  return count;
+}
+
+static bool magnitude_bit(std::span<const uint8_t> magnitude, size_t n) noexcept {
+  return n / 8 < magnitude.size() && ((magnitude[n / 8] >> (n % 8)) & 1) != 0;
+}
+
+// -m is ~(m - 1), so below the lowest set bit of m it is zero, at it one, and above it the inverse of m
+static bool twos_complement_bit(const mtmath::BigIntView &value, size_t n) noexcept {
+  if (!value.is_negative()) {
+    return magnitude_bit(value.magnitude(), n);
+  }
+  auto zeros = trailing_zero_bits(value.magnitude());
+  return n == zeros || (n > zeros && !magnitude_bit(value.magnitude(), n));
+}
+
+// One word of -x = ~x + 1, carrying into the next word only while the words so far are zero
+static uint64_t negate_word(uint64_t word, uint64_t &carry) noexcept {
+  auto res = ~word + carry;
+  carry = carry && word == 0;
+  return res;
+}
+
+namespace {
+  enum class BitwiseOp { AND, OR, XOR };
+
+  template<typename T>
+  T apply(BitwiseOp op, T a, T b) noexcept {
+    switch (op) {
+      case BitwiseOp::AND:
+        return a & b;
+      case BitwiseOp::OR:
+        return a | b;
+      default:
+        return a ^ b;
+    }
+  }
+}
+
+// Sign and magnitude of a op b. Negative operands are turned into two's complement one word at a time as they are
+// read, and a negative result is turned back the same way as it is written
+static std::tuple<bool, mtmath::ByteArray> bitwise(const mtmath::BigIntView &a, const mtmath::BigIntView &b, BitwiseOp op) {
+  auto negative = apply(op, a.is_negative(), b.is_negative());
+  // The extra word holds the sign extension, which a negative result's magnitude can carry into
+  auto words = std::max(magnitude_words(a.magnitude()), magnitude_words(b.magnitude())) + 1;
+  std::vector<uint8_t> out(words * sizeof(uint64_t));
+  uint64_t aCarry = 1;
+  uint64_t bCarry = 1;
+  uint64_t outCarry = 1;
+  for (size_t i = 0; i < words; ++i) {
+    auto x = magnitude_word(a.magnitude(), i);
+    auto y = magnitude_word(b.magnitude(), i);
+    if (a.is_negative()) {
+      x = negate_word(x, aCarry);
+    }
+    if (b.is_negative()) {
+      y = negate_word(y, bCarry);
+    }
+    auto word = apply(op, x, y);
+    if (negative) {
+      word = negate_word(word, outCarry);
+    }
+    for (size_t j = 0; j < sizeof(uint64_t); ++j) {
+      out[i * sizeof(uint64_t) + j] = static_cast<uint8_t>(word >> (8 * j));
+    }
+  }
+  return std::make_tuple(negative, mtmath::ByteArray{std::move(out)});
+}
+
+size_t mtmath::BigInt::trailing_zeros() const noexcept {
+  return trailing_zero_bits(view().magnitude());
+}
+
+size_t mtmath::BigInt::popcount() const noexcept {
+  return popcount_bits(view().magnitude());
+}
+
+bool mtmath::BigInt::test_bit(size_t n) const noexcept {
+  return is_valid() && twos_complement_bit(view(), n);
+}
+
+mtmath::BigInt &mtmath::BigInt::set_bit(size_t n, bool value) {
+  if (!is_valid() || test_bit(n) == value) {
+    return *this;
+  }
+  if (!is_negative()) {
+    if (n / 8 >= digits.size()) {
+      digits.resize(n / 8 + 1);
+    }
+    digits[n / 8] ^= static_cast<uint8_t>(1U << (n % 8));
+    simplify();
+    return *this;
+  }
+  // In two's complement setting a clear bit adds 2^n and clearing a set one takes it away
+  auto power = BigInt::one() << n;
+  return value ? *this += power : *this -= power;
+}
+
+mtmath::BigInt &mtmath::BigInt::operator&=(const mtmath::BigIntView &o) noexcept {
+  if (!is_valid() || !o.is_valid()) {
+    flags |= INVALID;
+    return *this;
+  }
+  auto [negative, bytes] = bitwise(view(), o, BitwiseOp::AND);
+  *this = BigInt{static_cast<uint8_t>(negative ? NEGATIVE : 0x0), std::move(bytes)};
+  simplify();
+  return *this;
+}
+
+mtmath::BigInt &mtmath::BigInt::operator|=(const mtmath::BigIntView &o) noexcept {
+  if (!is_valid() || !o.is_valid()) {
+    flags |= INVALID;
+    return *this;
+  }
+  auto [negative, bytes] = bitwise(view(), o, BitwiseOp::OR);
+  *this = BigInt{static_cast<uint8_t>(negative ? NEGATIVE : 0x0), std::move(bytes)};
+  simplify();
+  return *this;
+}
+
+mtmath::BigInt &mtmath::BigInt::operator^=(const mtmath::BigIntView &o) noexcept {
+  if (!is_valid() || !o.is_valid()) {
+    flags |= INVALID;
+    return *this;
+  }
+  auto [negative, bytes] = bitwise(view(), o, BitwiseOp::XOR);
+  *this = BigInt{static_cast<uint8_t>(negative ? NEGATIVE : 0x0), std::move(bytes)};
+  simplify();
+  return *this;
+}
+
+mtmath::BigInt mtmath::BigInt::operator~() const {
+  auto res = -*this;
+  res -= 1;
+  return res;
+}
+
+size_t mtmath::immut::BigInt::trailing_zeros() const noexcept {
+  return trailing_zero_bits(view().magnitude());
+}
+
+size_t mtmath::immut::BigInt::popcount() const noexcept {
+  return popcount_bits(view().magnitude());
+}
+
+bool mtmath::immut::BigInt::test_bit(size_t n) const noexcept {
+  return is_valid() && twos_complement_bit(view(), n);
+}
+
+mtmath::immut::BigInt mtmath::immut::BigInt::set_bit(size_t n, bool value) const {
+  if (!is_valid() || test_bit(n) == value) {
+    return *this;
+  }
+  auto res = to_mut();
+  res.set_bit(n, value);
+  return res.to_immut();
+}
+
+mtmath::immut::BigInt mtmath::immut::BigInt::operator&(const mtmath::immut::BigInt &o) const {
+  if (!is_valid() || !o.is_valid()) {
+    return invalidConst;
+  }
+  auto [negative, bytes] = bitwise(view(), o.view(), BitwiseOp::AND);
+  return BigInt{static_cast<uint8_t>(negative ? NEGATIVE : 0x0), std::make_shared<ByteArray>(std::move(bytes))};
+}
+
+mtmath::immut::BigInt mtmath::immut::BigInt::operator|(const mtmath::immut::BigInt &o) const {
+  if (!is_valid() || !o.is_valid()) {
+    return invalidConst;
+  }
+  auto [negative, bytes] = bitwise(view(), o.view(), BitwiseOp::OR);
+  return BigInt{static_cast<uint8_t>(negative ? NEGATIVE : 0x0), std::make_shared<ByteArray>(std::move(bytes))};
+}
+
+mtmath::immut::BigInt mtmath::immut::BigInt::operator^(const mtmath::immut::BigInt &o) const {
+  if (!is_valid() || !o.is_valid()) {
+    return invalidConst;
+  }
+  auto [negative, bytes] = bitwise(view(), o.view(), BitwiseOp::XOR);
+  return BigInt{static_cast<uint8_t>(negative ? NEGATIVE : 0x0), std::make_shared<ByteArray>(std::move(bytes))};
+}
+
+mtmath::immut::BigInt mtmath::immut::BigInt::operator~() const {
+  return -*this - 1;
+}
+
+size_t mtmath::immut::BigInt::bit_length() const noexcept {
+  if (!is_valid() || digits->empty()) {
+    return 0;
+  }
+  return (digits->size() - 1) * 8 + static_cast<size_t>(std::bit_width((*digits)[digits->size() - 1]));
+}
+
+double mtmath::immut::BigInt::frexp(int64_t &exponent) const noexcept {
+  if (!is_valid()) {
+    exponent = 0;
+    return 0.0;
+  }
+  return leading_mantissa(*digits, is_negative(), bit_length(), exponent);
+}
+
+double mtmath::immut::BigInt::to_double(int64_t scale) const noexcept {
+  if (!is_valid()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return magnitude_to_double(*digits, is_negative(), bit_length(), scale);
+}
+
+mtmath::immut::BigInt mtmath::immut::BigInt::from_double(double value) {
+  return mtmath::BigInt::from_double(value).to_immut();
+}
+
 int64_t mtmath::immut::BigInt::as_i64() const noexcept {
   auto val = static_cast<int64_t>(digits->as<uint64_t>() & 0x7fffffffffffffff);
   if (is_negative()) {
@@ -722,3 +1403,170 @@ int64_t mtmath::immut::BigInt::as_i64() const noexcept {
   }
   return val;
 }
+
+// Single word kernels for mixed BigInt and machine integer arithmetic. They pad the magnitude to whole words and run
+// the limbs word kernels over it in place
+
+// Little-endian bytes of value, padded to a whole word
+static std::array<uint8_t, sizeof(uint64_t)> word_bytes(uint64_t value) noexcept {
+  std::array<uint8_t, sizeof(uint64_t)> bytes{};
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+  return bytes;
+}
+
+// Pads the magnitude to whole words so the word kernels can run over it; callers trim afterwards
+static void pad_to_words(mtmath::ByteArray &digits, size_t extraWords = 0) {
+  digits.resize((digits.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t) + extraWords * sizeof(uint64_t));
+}
+
+static void add_word_magnitude(mtmath::ByteArray &digits, uint64_t value) {
+  auto word = word_bytes(value);
+  pad_to_words(digits);
+  if (digits.empty()) {
+    digits.resize(word.size());
+  }
+  if (mtmath::limbs::add_bytes(digits.data(), digits.size(), word.data(), word.size())) {
+    digits.emplace_back(1);
+  }
+  digits.simplify();
+}
+
+// Requires the magnitude to be at least value; leaves leading zeros for the caller to trim
+static void sub_word_magnitude(mtmath::ByteArray &digits, uint64_t value) {
+  auto word = word_bytes(value);
+  pad_to_words(digits);
+  mtmath::limbs::sub_bytes(digits.data(), digits.data(), digits.size(), word.data(), word.size());
+}
+
+static int compare_word_magnitude(const mtmath::ByteArray &digits, uint64_t value) noexcept {
+  if (digits.size() > sizeof(uint64_t)) {
+    return 1;
+  }
+  auto current = digits.as<uint64_t>();
+  return current < value ? -1 : (current > value ? 1 : 0);
+}
+
+static void mul_word_magnitude(mtmath::ByteArray &digits, uint64_t value) {
+  pad_to_words(digits, 1);
+  mtmath::limbs::mul_1_bytes(digits.data(), digits.size() - sizeof(uint64_t), value);
+  digits.simplify();
+}
+
+// Replaces the magnitude with the quotient and returns the remainder; leaves leading zeros for the caller to trim
+static uint64_t divmod_word_magnitude(mtmath::ByteArray &digits, uint64_t value) {
+  pad_to_words(digits);
+  return mtmath::limbs::divrem_1_bytes(digits.data(), digits.size(), value);
+}
+
+mtmath::BigInt& mtmath::BigInt::add_word(bool negative, uint64_t magnitude) noexcept {
+  if (!is_valid() || magnitude == 0) {
+    return *this;
+  }
+  if (is_zero() || is_negative() == negative) {
+    add_word_magnitude(digits, magnitude);
+    flags = negative ? NEGATIVE : 0x0;
+  }
+  else if (compare_word_magnitude(digits, magnitude) >= 0) {
+    sub_word_magnitude(digits, magnitude);
+    simplify();
+  }
+  else {
+    // |this| < magnitude so it fits in a word and the sign flips
+    auto current = digits.as<uint64_t>();
+    digits.clear();
+    add_word_magnitude(digits, magnitude - current);
+    flags ^= NEGATIVE;
+  }
+  return *this;
+}
+
+mtmath::BigInt& mtmath::BigInt::mul_word(bool negative, uint64_t magnitude) noexcept {
+  if (!is_valid()) {
+    return *this;
+  }
+  if (magnitude == 0 || is_zero()) {
+    *this = BigInt::zero();
+    return *this;
+  }
+  mul_word_magnitude(digits, magnitude);
+  if (negative) {
+    flags ^= NEGATIVE;
+  }
+  return *this;
+}
+
+mtmath::BigInt& mtmath::BigInt::div_word(bool negative, uint64_t magnitude, bool remainder) noexcept {
+  if (!is_valid() || magnitude == 0) {
+    *this = BigInt::invalid();
+    return *this;
+  }
+  auto rem = divmod_word_magnitude(digits, magnitude);
+  if (remainder) {
+    digits.clear();
+    add_word_magnitude(digits, rem);
+  }
+  else if (negative) {
+    flags ^= NEGATIVE;
+  }
+  simplify();
+  return *this;
+}
+
+std::strong_ordering mtmath::BigInt::compare_word(bool negative, uint64_t magnitude) const noexcept {
+  if (!is_valid()) {
+    return std::strong_ordering::less;
+  }
+  auto sign = is_zero() ? 0 : (is_negative() ? -1 : 1);
+  auto otherSign = magnitude == 0 ? 0 : (negative ? -1 : 1);
+  if (sign != otherSign) {
+    return sign <=> otherSign;
+  }
+  auto cmp = compare_word_magnitude(digits, magnitude);
+  return negative ? 0 <=> cmp : cmp <=> 0;
+}
+
+mtmath::BigInt mtmath::immut::BigInt::to_mut_for_word() const {
+  if (!is_valid()) {
+    return to_mut();
+  }
+  // Padding to whole words plus a carry word, so the kernels never reallocate
+  auto res = mtmath::BigInt{flags, ByteArray{}};
+  res.digits.reserve(digits->size() + 2 * sizeof(uint64_t));
+  res.digits.resize(digits->size());
+  std::copy(digits->begin(), digits->end(), res.digits.begin());
+  return res;
+}
+
+// The magnitude is copied once into storage with room for the result, which then moves into the shared digits
+mtmath::immut::BigInt mtmath::immut::BigInt::add_word(bool negative, uint64_t magnitude) const noexcept {
+  auto res = to_mut_for_word();
+  res.add_word(negative, magnitude);
+  return std::move(res).to_immut();
+}
+
+mtmath::immut::BigInt mtmath::immut::BigInt::mul_word(bool negative, uint64_t magnitude) const noexcept {
+  auto res = to_mut_for_word();
+  res.mul_word(negative, magnitude);
+  return std::move(res).to_immut();
+}
+
+mtmath::immut::BigInt mtmath::immut::BigInt::div_word(bool negative, uint64_t magnitude, bool remainder) const noexcept {
+  auto res = to_mut_for_word();
+  res.div_word(negative, magnitude, remainder);
+  return std::move(res).to_immut();
+}
+
+std::strong_ordering mtmath::immut::BigInt::compare_word(bool negative, uint64_t magnitude) const noexcept {
+  if (!is_valid()) {
+    return std::strong_ordering::less;
+  }
+  auto sign = is_zero() ? 0 : (is_negative() ? -1 : 1);
+  auto otherSign = magnitude == 0 ? 0 : (negative ? -1 : 1);
+  if (sign != otherSign) {
+    return sign <=> otherSign;
+  }
+  auto cmp = compare_word_magnitude(*digits, magnitude);
+  return negative ? 0 <=> cmp : cmp <=> 0;
+}
@@ -2,24 +2,132 @@
 
 #include <vector>
 #include <string>
+#include <charconv>
 #include <tuple>
 #include "byte_array.h"
 #include <compare>
 #include "../mtmath_c.h"
 #include <optional>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <ostream>
+#include <span>
 
 namespace mtmath {
   class BigInt;
+  class BigIntView;
 
   namespace c {
     void into(const mtmath::BigInt& bi, MtMath_BigInt* out);
     void into(const MtMath_BigInt& cbi, mtmath::BigInt* out);
+    /** Views a C BigInt's bytes without copying them. Leading zero bytes are left out of the view */
+    mtmath::BigIntView view(const MtMath_BigInt& cbi) noexcept;
   }
 
   namespace immut {
     class BigInt;
   }
 
+  /**
+   * Like std::to_chars, writes value in base 2 to 36 (lowercase, no prefix) into [first, last) without allocating.
+   * The magnitude is divided down in place at the back of the buffer while digits are written at the front.
+   * Returns errc::value_too_large if it does not fit. Invalid values write NaN
+   */
+  std::to_chars_result to_chars(char* first, char* last, const BigInt& value, int base = 10) noexcept;
+  std::to_chars_result to_chars(char* first, char* last, const immut::BigInt& value, int base = 10) noexcept;
+  std::to_chars_result to_chars(char* first, char* last, const BigIntView& value, int base = 10) noexcept;
+
+  /**
+   * Buffer size which to_chars is guaranteed to fit in. Exact for power of two bases, otherwise at most one
+   * more than needed, since the exact count would need a comparison against a power of the base
+   */
+  size_t to_chars_size(const BigInt& value, int base = 10) noexcept;
+  size_t to_chars_size(const immut::BigInt& value, int base = 10) noexcept;
+  size_t to_chars_size(const BigIntView& value, int base = 10) noexcept;
+
+  /**
+   * Like std::from_chars, reads an optional '-' and digits of the base from [first, last) into value. The digits
+   * are built in value's existing storage, so no temporary strings or numbers are made. Value is untouched and
+   * errc::invalid_argument returned if there are no digits
+   */
+  std::from_chars_result from_chars(const char* first, const char* last, BigInt& value, int base = 10);
+  std::from_chars_result from_chars(const char* first, const char* last, immut::BigInt& value, int base = 10);
+
+  /**
+   * Machine integers which BigInt operates on directly with single word kernels, without building a temporary BigInt
+   */
+  template<typename I>
+  concept WordInteger = std::integral<I> && sizeof(I) <= sizeof(uint64_t);
+
+  /**
+   * Splits a machine integer into (is negative, magnitude)
+   */
+  template<WordInteger I>
+  constexpr std::tuple<bool, uint64_t> split_word(I v) noexcept {
+    if constexpr (std::is_signed_v<I>) {
+      return std::make_tuple(v < 0, v < 0 ? uint64_t{0} - static_cast<uint64_t>(v) : static_cast<uint64_t>(v));
+    }
+    else {
+      return std::make_tuple(false, static_cast<uint64_t>(v));
+    }
+  }
+
+  /**
+   * Splits a finite double into (is negative, mantissa, exponent) with |value| = mantissa * 2^exponent.
+   * The mantissa is odd unless the value is zero, so mantissa / 2^-exponent is already in lowest terms
+   */
+  constexpr std::tuple<bool, uint64_t, int64_t> split_double(double v) noexcept {
+    auto bits = std::bit_cast<uint64_t>(v);
+    auto negative = (bits >> 63) != 0;
+    auto biasedExponent = static_cast<int64_t>((bits >> 52) & 0x7ff);
+    auto mantissa = bits & ((uint64_t{1} << 52) - 1);
+    if (biasedExponent == 0) {
+      // Subnormals have no implicit leading bit
+      biasedExponent = 1;
+    }
+    else {
+      mantissa |= uint64_t{1} << 52;
+    }
+    if (mantissa == 0) {
+      return std::make_tuple(negative, uint64_t{0}, int64_t{0});
+    }
+    auto trailing = std::countr_zero(mantissa);
+    return std::make_tuple(negative, mantissa >> trailing, biasedExponent - 1075 + trailing);
+  }
+
+  /**
+   * Read-only integer over bytes owned by someone else, such as a serialized buffer. The magnitude has the same
+   * little-endian byte layout as BigInt, so it is referenced rather than copied.
+   * BigInt accepts views wherever it only reads an operand, so such data never has to be copied into a BigInt first
+   */
+  class BigIntView {
+    std::span<const uint8_t> bytes = {};
+    bool negative = false;
+    bool valid = true;
+
+  public:
+    BigIntView() = default;
+    /** Magnitude must not have a leading zero byte */
+    explicit BigIntView(std::span<const uint8_t> magnitude, bool negative = false, bool valid = true) noexcept
+        : bytes(magnitude), negative(negative && !magnitude.empty()), valid(valid) {}
+
+    [[nodiscard]] bool is_zero() const noexcept { return bytes.empty(); }
+    [[nodiscard]] bool is_valid() const noexcept { return valid; }
+    [[nodiscard]] bool is_negative() const noexcept { return negative; }
+    [[nodiscard]] std::span<const uint8_t> magnitude() const noexcept { return bytes; }
+    /** Same output as BigInt::to_string */
+    [[nodiscard]] std::optional<std::string> to_string(int base) const;
+
+    /**
+     * Views one serialized integer at the front of in without copying it. Sets consumed to the bytes read.
+     * Empty if the encoding is malformed, truncated, not canonical or from another version
+     */
+    static std::optional<BigIntView> deserialize(std::span<const std::byte> in, size_t* consumed = nullptr) noexcept;
+  };
+
   class BigInt {
     enum FLAGS {
       NEGATIVE = 0x1,
@@ -45,10 +153,29 @@ namespace mtmath {
     bool is_zero() const noexcept { return digits.empty(); }
     bool is_valid() const noexcept { return !(flags & INVALID); }
     bool is_negative() const noexcept { return flags & NEGATIVE; }
+    /** Number of bits needed for the magnitude, 0 for zero */
+    size_t bit_length() const noexcept {
+      return digits.empty() ? 0 : (digits.size() - 1) * 8 + static_cast<size_t>(std::bit_width(digits[digits.size() - 1]));
+    }
+    /** Number of trailing zero bits of the magnitude, 0 for zero */
+    size_t trailing_zeros() const noexcept;
+    /** Number of set bits in the magnitude */
+    size_t popcount() const noexcept;
+    /** Bit n of the two's complement form, where negatives have infinitely many leading ones */
+    bool test_bit(size_t n) const noexcept;
+    /** Sets or clears bit n of the two's complement form */
+    BigInt& set_bit(size_t n, bool value = true);
 
     BigInt& abs() noexcept { flags &= ~NEGATIVE; return *this; }
     BigInt abs_val() const noexcept { auto copy = *this; return copy.abs(); }
 
+    /** Bytes of digit storage held. Shrinking the value keeps its storage for later growth */
+    size_t capacity() const noexcept { return digits.capacity(); }
+    /** Makes room for a magnitude of the given number of bytes, so a loop building up a value does not reallocate */
+    BigInt& reserve(size_t bytes) { digits.reserve(bytes); return *this; }
+    /** Gives back digit storage the value no longer needs */
+    BigInt& shrink() { digits.shrink(); return *this; }
+
     template<typename T>
     BigInt(const T& number, int base) {
       static_assert(std::is_same_v<std::decay_t<T>, std::string> || std::is_same_v<std::decay_t<T>, std::string_view>
@@ -113,13 +240,16 @@ namespace mtmath {
     explicit BigInt(const std::string_view& s) : BigInt(s, 10) {}
     explicit BigInt(const char* c) : BigInt(c, 10) {}
 
+    explicit BigInt(const BigIntView& view);
+
     template<typename T>
     BigInt(const T& number) {
       static_assert(std::numeric_limits<T>::is_integer, "Can only initialize from strings and integers");
-      auto n = number;
-      if (n < 0) {
+      // Negate in unsigned arithmetic so the most negative value does not overflow
+      auto n = static_cast<std::make_unsigned_t<T>>(number);
+      if (number < 0) {
         flags |= NEGATIVE;
-        n *= -1;
+        n = 0 - n;
       }
       while (n > 0) {
         digits.emplace_back(n & std::numeric_limits<uint8_t>::max());
@@ -128,42 +258,162 @@ namespace mtmath {
       simplify();
     }
 
-    std::optional<std::string> to_string(int base) const;
+    /** Read-only view of the digits. Only valid until this is next modified or destroyed */
+    BigIntView view() const noexcept { return BigIntView{std::span{digits.data(), digits.size()}, is_negative(), is_valid()}; }
+
+    std::optional<std::string> to_string(int base) const { return view().to_string(base); }
     int64_t as_i64() const noexcept;
+    /**
+     * Like std::frexp, returns a signed mantissa in [0.5, 1) and sets exponent so that
+     * mantissa * 2^exponent approximates this to double precision. Zero gives 0 with an exponent of 0
+     */
+    double frexp(int64_t& exponent) const noexcept;
+    /**
+     * This * 2^scale rounded to the nearest double (ties to even). Only the leading 64 bits are read,
+     * the rest only matter for whether any of them are set. Invalid gives NaN
+     */
+    double to_double(int64_t scale = 0) const noexcept;
+    /**
+     * Exact integer part of a double, truncated toward zero. NaN and infinities give an invalid BigInt
+     */
+    static BigInt from_double(double value);
+    /** Bytes serialize writes: a version and sign byte, a varint byte count, then the little-endian magnitude */
+    [[nodiscard]] size_t serialized_size() const noexcept;
+    /** Writes the binary encoding to the front of out. Returns the bytes written, or 0 if out is too small */
+    size_t serialize(std::span<std::byte> out) const noexcept;
+    /** Reads one encoded integer from the front of in, see BigIntView::deserialize */
+    static std::optional<BigInt> deserialize(std::span<const std::byte> in, size_t* consumed = nullptr);
 
     BigInt operator-() const;
-    BigInt& operator+=(const BigInt& o) noexcept;
-    BigInt& operator-=(const BigInt& o) noexcept;
-    BigInt& operator/=(const BigInt& o) noexcept;
-    BigInt& operator%=(const BigInt& o) noexcept;
-    BigInt& operator*=(const BigInt& o) noexcept;
+    BigInt& operator+=(const BigIntView& o) noexcept;
+    BigInt& operator-=(const BigIntView& o) noexcept;
+    BigInt& operator/=(const BigIntView& o) noexcept;
+    BigInt& operator%=(const BigIntView& o) noexcept;
+    BigInt& operator*=(const BigIntView& o) noexcept;
+    BigInt operator+(const BigIntView& o) const { auto copy = *this; return copy += o; }
+    BigInt operator-(const BigIntView& o) const { auto copy = *this; return copy -= o; }
+    BigInt operator/(const BigIntView& o) const { auto copy = *this; return copy /= o; }
+    BigInt operator%(const BigIntView& o) const { auto copy = *this; return copy %= o; }
+    BigInt operator*(const BigIntView& o) const { auto copy = *this; return copy *= o; }
+    std::tuple<BigInt, BigInt> divide(const BigIntView& denominator) const noexcept;
+
+    BigInt& operator+=(const BigInt& o) noexcept { return *this += o.view(); }
+    BigInt& operator-=(const BigInt& o) noexcept { return *this -= o.view(); }
+    BigInt& operator/=(const BigInt& o) noexcept { return *this /= o.view(); }
+    BigInt& operator%=(const BigInt& o) noexcept { return *this %= o.view(); }
+    BigInt& operator*=(const BigInt& o) noexcept { return *this *= o.view(); }
     BigInt operator+(const BigInt& o) const { auto copy = *this; return copy += o; }
     BigInt operator-(const BigInt& o) const { auto copy = *this; return copy -= o; }
     BigInt operator/(const BigInt& o) const { auto copy = *this; return copy /= o; }
     BigInt operator%(const BigInt& o) const { auto copy = *this; return copy %= o; }
     BigInt operator*(const BigInt& o) const { auto copy = *this; return copy *= o; }
-    std::tuple<BigInt, BigInt> divide(const BigInt& denominator) const noexcept;
-
-    std::strong_ordering operator<=>(const BigInt& o) const noexcept;
+    std::tuple<BigInt, BigInt> divide(const BigInt& denominator) const noexcept { return divide(denominator.view()); }
+
+    /**
+     * Bitwise operators on the two's complement forms, as if negatives had infinitely many leading ones.
+     * Each is one pass over the words of both operands
+     */
+    BigInt& operator&=(const BigIntView& o) noexcept;
+    BigInt& operator|=(const BigIntView& o) noexcept;
+    BigInt& operator^=(const BigIntView& o) noexcept;
+    BigInt operator&(const BigIntView& o) const { auto copy = *this; return copy &= o; }
+    BigInt operator|(const BigIntView& o) const { auto copy = *this; return copy |= o; }
+    BigInt operator^(const BigIntView& o) const { auto copy = *this; return copy ^= o; }
+    BigInt& operator&=(const BigInt& o) noexcept { return *this &= o.view(); }
+    BigInt& operator|=(const BigInt& o) noexcept { return *this |= o.view(); }
+    BigInt& operator^=(const BigInt& o) noexcept { return *this ^= o.view(); }
+    BigInt operator&(const BigInt& o) const { auto copy = *this; return copy &= o; }
+    BigInt operator|(const BigInt& o) const { auto copy = *this; return copy |= o; }
+    BigInt operator^(const BigInt& o) const { auto copy = *this; return copy ^= o; }
+    /** -this - 1 */
+    BigInt operator~() const;
+
+    template<WordInteger I>
+    BigInt& operator+=(I v) noexcept { auto [negative, magnitude] = split_word(v); return add_word(negative, magnitude); }
+    template<WordInteger I>
+    BigInt& operator-=(I v) noexcept { auto [negative, magnitude] = split_word(v); return add_word(!negative, magnitude); }
+    template<WordInteger I>
+    BigInt& operator*=(I v) noexcept { auto [negative, magnitude] = split_word(v); return mul_word(negative, magnitude); }
+    template<WordInteger I>
+    BigInt& operator/=(I v) noexcept { auto [negative, magnitude] = split_word(v); return div_word(negative, magnitude, false); }
+    template<WordInteger I>
+    BigInt& operator%=(I v) noexcept { auto [negative, magnitude] = split_word(v); return div_word(negative, magnitude, true); }
+    template<WordInteger I>
+    BigInt operator+(I v) const { auto copy = *this; return copy += v; }
+    template<WordInteger I>
+    BigInt operator-(I v) const { auto copy = *this; return copy -= v; }
+    template<WordInteger I>
+    BigInt operator*(I v) const { auto copy = *this; return copy *= v; }
+    template<WordInteger I>
+    BigInt operator/(I v) const { auto copy = *this; return copy /= v; }
+    template<WordInteger I>
+    BigInt operator%(I v) const { auto copy = *this; return copy %= v; }
+    /**
+     * Quotient for a denominator known to divide this exactly. Skips the remainder entirely, so the
+     * result is meaningless if the division is not exact
+     */
+    BigInt divexact(const BigIntView& denominator) const noexcept;
+    BigInt divexact(const BigInt& denominator) const noexcept { return divexact(denominator.view()); }
+
+    /**
+     * Greatest common divisor of |a| and |b|. Uses Lehmer's algorithm for medium sized numbers and
+     * switches to a recursive half-gcd for very large ones
+     */
+    static BigInt gcd(const BigIntView& a, const BigIntView& b);
+    static BigInt gcd(const BigInt& a, const BigInt& b) { return gcd(a.view(), b.view()); }
+
+    /**
+     * Extended gcd. Returns (g, s, t) with g = gcd(a, b) = s * a + t * b.
+     * Cofactors are tracked through the same reduction steps as gcd
+     */
+    static std::tuple<BigInt, BigInt, BigInt> gcdext(const BigInt& a, const BigInt& b);
+
+    /**
+     * Inverse of a modulo |m| in the range [0, |m|). Invalid if m is zero or a and m are not coprime
+     */
+    static BigInt invmod(const BigInt& a, const BigInt& m);
+
+    std::strong_ordering operator<=>(const BigIntView& o) const noexcept;
+    bool operator==(const BigIntView& o) const noexcept {
+      return *this <=> o == std::strong_ordering::equal;
+    }
+    std::strong_ordering operator<=>(const BigInt& o) const noexcept { return *this <=> o.view(); }
     bool operator==(const BigInt& o) const noexcept {
       return *this <=> o == std::strong_ordering::equal;
     }
+    template<WordInteger I>
+    std::strong_ordering operator<=>(I v) const noexcept { auto [negative, magnitude] = split_word(v); return compare_word(negative, magnitude); }
+    template<WordInteger I>
+    bool operator==(I v) const noexcept { return *this <=> v == std::strong_ordering::equal; }
 
-    BigInt operator>>(size_t i) const { auto copy = *this; copy >>= i; return copy; }
-    BigInt operator<<(size_t i) const { auto copy = *this; copy <<= i; return copy; }
+    BigInt operator>>(size_t i) const;
+    BigInt operator<<(size_t i) const;
     BigInt& operator<<=(size_t i);
     BigInt& operator>>=(size_t i);
 
-    immut::BigInt to_immut() const;
+    immut::BigInt to_immut() const&;
+    /** Moves the digits into the immutable value rather than copying them */
+    immut::BigInt to_immut() &&;
 
     friend ::mtmath::immut::BigInt;
+    friend std::to_chars_result mtmath::to_chars(char* first, char* last, const BigInt& value, int base) noexcept;
+    friend std::from_chars_result mtmath::from_chars(const char* first, const char* last, BigInt& value, int base);
     friend void ::mtmath::c::into(const BigInt& bi, MtMath_BigInt* out);
     friend void ::mtmath::c::into(const MtMath_BigInt& cbi, BigInt* out);
+    friend BigIntView mtmath::c::view(const MtMath_BigInt& cbi) noexcept;
 
   private:
     void simplify();
     void compress(int base);
-    int abs_compare(const BigInt& o) const noexcept;
+    int abs_compare(std::span<const uint8_t> o) const noexcept;
+    // Adds or subtracts a magnitude from this one's, ignoring the signs
+    void add_magnitude(std::span<const uint8_t> o) noexcept;
+    void sub_magnitude(std::span<const uint8_t> o) noexcept;
+
+    BigInt& add_word(bool negative, uint64_t magnitude) noexcept;
+    BigInt& mul_word(bool negative, uint64_t magnitude) noexcept;
+    BigInt& div_word(bool negative, uint64_t magnitude, bool remainder) noexcept;
+    std::strong_ordering compare_word(bool negative, uint64_t magnitude) const noexcept;
   };
 
   namespace immut {
@@ -177,6 +427,10 @@ namespace mtmath {
       std::shared_ptr<ByteArray> digits = std::make_shared<ByteArray>();
       BigInt(uint8_t flags, std::shared_ptr<ByteArray> digits);
 
+      // Builds the shared constants without simplifying (simplify would read the constant being built)
+      struct ConstantTag {};
+      BigInt(ConstantTag, uint8_t flags, std::shared_ptr<ByteArray> digits) : flags(flags), digits(std::move(digits)) {}
+
       static BigInt zeroConst;
       static BigInt oneConst;
       static BigInt twoConst;
@@ -199,10 +453,25 @@ namespace mtmath {
       bool is_zero() const noexcept;
       bool is_valid() const noexcept;
       bool is_negative() const noexcept;
+      /** Read-only view of the shared digits. Only valid while this or a copy of it is alive */
+      BigIntView view() const noexcept;
 
       BigInt abs() const noexcept;
       BigInt abs_val() const noexcept { return abs(); }
       int64_t as_i64() const noexcept;
+      size_t bit_length() const noexcept;
+      size_t trailing_zeros() const noexcept;
+      size_t popcount() const noexcept;
+      /** Same bit numbering as mtmath::BigInt::test_bit */
+      bool test_bit(size_t n) const noexcept;
+      BigInt set_bit(size_t n, bool value = true) const;
+      double frexp(int64_t& exponent) const noexcept;
+      double to_double(int64_t scale = 0) const noexcept;
+      static BigInt from_double(double value);
+      [[nodiscard]] size_t serialized_size() const noexcept;
+      /** Same encoding as mtmath::BigInt::serialize */
+      size_t serialize(std::span<std::byte> out) const noexcept;
+      static std::optional<BigInt> deserialize(std::span<const std::byte> in, size_t* consumed = nullptr);
 
       template<typename T>
       BigInt(const T& number, int base) {
@@ -268,13 +537,16 @@ namespace mtmath {
       explicit BigInt(const std::string_view& s) : BigInt(s, 10) {}
       explicit BigInt(const char* c) : BigInt(c, 10) {}
 
+      explicit BigInt(const BigIntView& view);
+
       template<typename T>
       BigInt(const T& number) {
         static_assert(std::numeric_limits<T>::is_integer, "Can only initialize from strings and integers");
-        auto n = number;
-        if (n < 0) {
+        // Negate in unsigned arithmetic so the most negative value does not overflow
+        auto n = static_cast<std::make_unsigned_t<T>>(number);
+        if (number < 0) {
           flags |= NEGATIVE;
-          n *= -1;
+          n = 0 - n;
         }
         while (n > 0) {
           digits->emplace_back(n & std::numeric_limits<uint8_t>::max());
@@ -293,15 +565,42 @@ namespace mtmath {
       BigInt operator*(const BigInt& o) const noexcept;
       std::tuple<BigInt, BigInt> divide(const BigInt& denominator) const noexcept;
 
+      /** Two's complement bitwise operators, see mtmath::BigInt */
+      BigInt operator&(const BigInt& o) const;
+      BigInt operator|(const BigInt& o) const;
+      BigInt operator^(const BigInt& o) const;
+      BigInt operator~() const;
+
+      template<WordInteger I>
+      BigInt operator+(I v) const noexcept { auto [negative, magnitude] = split_word(v); return add_word(negative, magnitude); }
+      template<WordInteger I>
+      BigInt operator-(I v) const noexcept { auto [negative, magnitude] = split_word(v); return add_word(!negative, magnitude); }
+      template<WordInteger I>
+      BigInt operator*(I v) const noexcept { auto [negative, magnitude] = split_word(v); return mul_word(negative, magnitude); }
+      template<WordInteger I>
+      BigInt operator/(I v) const noexcept { auto [negative, magnitude] = split_word(v); return div_word(negative, magnitude, false); }
+      template<WordInteger I>
+      BigInt operator%(I v) const noexcept { auto [negative, magnitude] = split_word(v); return div_word(negative, magnitude, true); }
+      BigInt divexact(const BigInt& denominator) const noexcept;
+
+      static BigInt gcd(const BigInt& a, const BigInt& b);
+      static std::tuple<BigInt, BigInt, BigInt> gcdext(const BigInt& a, const BigInt& b);
+      static BigInt invmod(const BigInt& a, const BigInt& m);
+
       std::strong_ordering operator<=>(const BigInt& o) const noexcept;
       bool operator==(const BigInt& o) const noexcept {
         return *this <=> o == std::strong_ordering::equal;
       }
+      template<WordInteger I>
+      std::strong_ordering operator<=>(I v) const noexcept { auto [negative, magnitude] = split_word(v); return compare_word(negative, magnitude); }
+      template<WordInteger I>
+      bool operator==(I v) const noexcept { return *this <=> v == std::strong_ordering::equal; }
 
       BigInt operator<<(size_t i) const noexcept;
       BigInt operator>>(size_t i) const noexcept;
 
       friend ::mtmath::BigInt;
+      friend std::to_chars_result mtmath::to_chars(char* first, char* last, const BigInt& value, int base) noexcept;
 
       ::mtmath::BigInt to_mut() const;
 
@@ -309,6 +608,13 @@ namespace mtmath {
       void simplify();
       void compress(int base);
       bool abs_less_than(const BigInt& o) const noexcept;
+
+      // Mutable copy with room reserved for the single word kernels to grow in place
+      ::mtmath::BigInt to_mut_for_word() const;
+      BigInt add_word(bool negative, uint64_t magnitude) const noexcept;
+      BigInt mul_word(bool negative, uint64_t magnitude) const noexcept;
+      BigInt div_word(bool negative, uint64_t magnitude, bool remainder) const noexcept;
+      std::strong_ordering compare_word(bool negative, uint64_t magnitude) const noexcept;
     };
   }
 }
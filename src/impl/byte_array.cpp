@@ -1,12 +1,283 @@
 #include "byte_array.h"
+#include <atomic>
+#include <cstddef>
 
-std::strong_ordering mtmath::ByteArray::operator<=>(const ByteArray& o) const noexcept {
-  for (size_t i = 0; i < o.bytes.size() && i < bytes.size(); ++i) {
-    if (bytes[i] != o.bytes[i]) {
-      return bytes[i] < o.bytes[i] ? std::strong_ordering::less : std::strong_ordering::greater;
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MTMATH_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+using mtmath::SimdLevel;
+
+static uint64_t load_le(const uint8_t *src) noexcept {
+  uint64_t word = 0;
+  if constexpr (std::endian::native == std::endian::little) {
+    memcpy(&word, src, sizeof(word));
+  }
+  else {
+    for (size_t i = 0; i < sizeof(word); ++i) {
+      word |= static_cast<uint64_t>(src[i]) << (8 * i);
+    }
+  }
+  return word;
+}
+
+static void store_le(uint8_t *dst, uint64_t word) noexcept {
+  if constexpr (std::endian::native == std::endian::little) {
+    memcpy(dst, &word, sizeof(word));
+  }
+  else {
+    for (size_t i = 0; i < sizeof(word); ++i) {
+      dst[i] = static_cast<uint8_t>(word >> (8 * i));
     }
   }
-  return bytes.size() <=> o.bytes.size();
+}
+
+enum class BitOp { AND, OR, XOR };
+
+template<BitOp OP, typename T>
+static T apply(T a, T b) noexcept {
+  if constexpr (OP == BitOp::AND) {
+    return a & b;
+  }
+  else if constexpr (OP == BitOp::OR) {
+    return a | b;
+  }
+  else {
+    return a ^ b;
+  }
+}
+
+// Word at a time, for the tails of the vector kernels and for targets without them
+template<BitOp OP>
+static void bitwise_words(uint8_t *dst, const uint8_t *src, size_t n) noexcept {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+    uint64_t a, b;
+    memcpy(&a, dst + i, sizeof(a));
+    memcpy(&b, src + i, sizeof(b));
+    a = apply<OP>(a, b);
+    memcpy(dst + i, &a, sizeof(a));
+  }
+  for (; i < n; ++i) {
+    dst[i] = apply<OP>(dst[i], src[i]);
+  }
+}
+
+// Scans down from the top, little-endian loads make the first differing word compare the right way round
+static int compare_words(const uint8_t *a, const uint8_t *b, size_t n) noexcept {
+  for (; n >= sizeof(uint64_t); n -= sizeof(uint64_t)) {
+    auto x = load_le(a + n - sizeof(uint64_t));
+    auto y = load_le(b + n - sizeof(uint64_t));
+    if (x != y) {
+      return x < y ? -1 : 1;
+    }
+  }
+  for (; n > 0; --n) {
+    if (a[n - 1] != b[n - 1]) {
+      return a[n - 1] < b[n - 1] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+static int compare_at(const uint8_t *a, const uint8_t *b, size_t index) noexcept {
+  return a[index] < b[index] ? -1 : 1;
+}
+
+#ifdef MTMATH_X86_SIMD
+// SSE2 is part of x86-64, so it needs no target attribute or runtime check
+template<BitOp OP>
+static void bitwise_sse2(uint8_t *dst, const uint8_t *src, size_t n) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+    auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i res;
+    if constexpr (OP == BitOp::AND) {
+      res = _mm_and_si128(a, b);
+    }
+    else if constexpr (OP == BitOp::OR) {
+      res = _mm_or_si128(a, b);
+    }
+    else {
+      res = _mm_xor_si128(a, b);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), res);
+  }
+  bitwise_words<OP>(dst + i, src + i, n - i);
+}
+
+static int compare_sse2(const uint8_t *a, const uint8_t *b, size_t n) noexcept {
+  for (; n >= 16; n -= 16) {
+    auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + n - 16));
+    auto y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + n - 16));
+    auto differ = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xffffU;
+    if (differ) {
+      // Highest differing byte decides
+      return compare_at(a, b, n - 16 + static_cast<size_t>(std::bit_width(differ)) - 1);
+    }
+  }
+  return compare_words(a, b, n);
+}
+
+template<BitOp OP>
+__attribute__((target("avx2"))) static void bitwise_avx2(uint8_t *dst, const uint8_t *src, size_t n) noexcept {
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+    auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    __m256i res;
+    if constexpr (OP == BitOp::AND) {
+      res = _mm256_and_si256(a, b);
+    }
+    else if constexpr (OP == BitOp::OR) {
+      res = _mm256_or_si256(a, b);
+    }
+    else {
+      res = _mm256_xor_si256(a, b);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), res);
+  }
+  bitwise_sse2<OP>(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) static int compare_avx2(const uint8_t *a, const uint8_t *b, size_t n) noexcept {
+  for (; n >= 32; n -= 32) {
+    auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + n - 32));
+    auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + n - 32));
+    auto differ = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+    if (differ) {
+      return compare_at(a, b, n - 32 + static_cast<size_t>(std::bit_width(differ)) - 1);
+    }
+  }
+  return compare_sse2(a, b, n);
+}
+
+template<BitOp OP>
+__attribute__((target("avx512f"))) static void bitwise_avx512(uint8_t *dst, const uint8_t *src, size_t n) noexcept {
+  size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    auto a = _mm512_loadu_si512(dst + i);
+    auto b = _mm512_loadu_si512(src + i);
+    __m512i res;
+    if constexpr (OP == BitOp::AND) {
+      res = _mm512_and_si512(a, b);
+    }
+    else if constexpr (OP == BitOp::OR) {
+      res = _mm512_or_si512(a, b);
+    }
+    else {
+      res = _mm512_xor_si512(a, b);
+    }
+    _mm512_storeu_si512(dst + i, res);
+  }
+  bitwise_avx2<OP>(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f,avx512bw"))) static int compare_avx512(const uint8_t *a, const uint8_t *b, size_t n) noexcept {
+  for (; n >= 64; n -= 64) {
+    auto x = _mm512_loadu_si512(a + n - 64);
+    auto y = _mm512_loadu_si512(b + n - 64);
+    auto differ = static_cast<uint64_t>(_mm512_cmpneq_epi8_mask(x, y));
+    if (differ) {
+      return compare_at(a, b, n - 64 + static_cast<size_t>(std::bit_width(differ)) - 1);
+    }
+  }
+  return compare_avx2(a, b, n);
+}
+#endif
+
+// Kernels behind the bitwise operators and comparison. Bitwise kernels combine n bytes of src into dst, compare
+// orders n bytes of a and b as little-endian numbers
+struct ByteKernels {
+  SimdLevel level;
+  void (*and_bytes)(uint8_t *dst, const uint8_t *src, size_t n) noexcept;
+  void (*or_bytes)(uint8_t *dst, const uint8_t *src, size_t n) noexcept;
+  void (*xor_bytes)(uint8_t *dst, const uint8_t *src, size_t n) noexcept;
+  int (*compare)(const uint8_t *a, const uint8_t *b, size_t n) noexcept;
+};
+
+static constexpr ByteKernels SCALAR_KERNELS = {SimdLevel::SCALAR, bitwise_words<BitOp::AND>, bitwise_words<BitOp::OR>,
+                                               bitwise_words<BitOp::XOR>, compare_words};
+#ifdef MTMATH_X86_SIMD
+static constexpr ByteKernels SSE2_KERNELS = {SimdLevel::SSE2, bitwise_sse2<BitOp::AND>, bitwise_sse2<BitOp::OR>,
+                                             bitwise_sse2<BitOp::XOR>, compare_sse2};
+static constexpr ByteKernels AVX2_KERNELS = {SimdLevel::AVX2, bitwise_avx2<BitOp::AND>, bitwise_avx2<BitOp::OR>,
+                                             bitwise_avx2<BitOp::XOR>, compare_avx2};
+static constexpr ByteKernels AVX512_KERNELS = {SimdLevel::AVX512, bitwise_avx512<BitOp::AND>, bitwise_avx512<BitOp::OR>,
+                                               bitwise_avx512<BitOp::XOR>, compare_avx512};
+#endif
+
+static SimdLevel supported_level() noexcept {
+#ifdef MTMATH_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+    return SimdLevel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+  return SimdLevel::SSE2;
+#else
+  return SimdLevel::SCALAR;
+#endif
+}
+
+static const ByteKernels *kernels_for(SimdLevel level) noexcept {
+#ifdef MTMATH_X86_SIMD
+  switch (level) {
+    case SimdLevel::AVX512:
+      return &AVX512_KERNELS;
+    case SimdLevel::AVX2:
+      return &AVX2_KERNELS;
+    case SimdLevel::SSE2:
+      return &SSE2_KERNELS;
+    default:
+      break;
+  }
+#endif
+  return &SCALAR_KERNELS;
+}
+
+static std::atomic<const ByteKernels *> &active_kernels() noexcept {
+  static std::atomic<const ByteKernels *> active{kernels_for(supported_level())};
+  return active;
+}
+
+static const ByteKernels &kernels() noexcept {
+  return *active_kernels().load(std::memory_order_relaxed);
+}
+
+SimdLevel mtmath::ByteArray::simd_level() noexcept {
+  return kernels().level;
+}
+
+SimdLevel mtmath::ByteArray::set_simd_level(SimdLevel level) noexcept {
+  auto used = std::min(level, supported_level());
+  active_kernels().store(kernels_for(used), std::memory_order_relaxed);
+  return used;
+}
+
+// Bytes up to and including the most significant non-zero one
+static size_t significant_size(const uint8_t *bytes, size_t size) noexcept {
+  while (size > 0 && bytes[size - 1] == 0) {
+    --size;
+  }
+  return size;
+}
+
+int mtmath::ByteArray::compare(const std::vector<uint8_t> &b) const noexcept {
+  auto size = significant_size(bytes.data(), bytes.size());
+  auto otherSize = significant_size(b.data(), b.size());
+  if (size != otherSize) {
+    return size < otherSize ? -1 : 1;
+  }
+  return kernels().compare(bytes.data(), b.data(), size);
+}
+
+std::strong_ordering mtmath::ByteArray::operator<=>(const ByteArray& o) const noexcept {
+  return compare(o) <=> 0;
 }
 
 mtmath::ByteArray mtmath::ByteArray::operator&(const std::vector<uint8_t> &b) const noexcept {
@@ -28,111 +299,178 @@ mtmath::ByteArray mtmath::ByteArray::operator^(const std::vector<uint8_t> &b) co
 }
 
 mtmath::ByteArray& mtmath::ByteArray::operator&=(const std::vector<uint8_t> &b) noexcept {
-  for (size_t i = 0; i < b.size() && i < bytes.size(); ++i) {
-    bytes[i] &= b[i];
-  }
   if (bytes.size() > b.size()) {
     bytes.resize(b.size());
   }
+  kernels().and_bytes(bytes.data(), b.data(), bytes.size());
   return *this;
 }
 
 mtmath::ByteArray& mtmath::ByteArray::operator|=(const std::vector<uint8_t> &b) noexcept {
-  if (bytes.size() < b.size()) {
-    bytes.resize(b.size());
-  }
-  for (size_t i = 0; i < b.size() && i < bytes.size(); ++i) {
-    bytes[i] |= b[i];
-  }
-  simplify();
+  auto common = std::min(bytes.size(), b.size());
+  kernels().or_bytes(bytes.data(), b.data(), common);
+  // Bytes past the end of this are just copied over
+  grow(std::max(bytes.size(), b.size()));
+  bytes.insert(bytes.end(), b.begin() + static_cast<std::vector<uint8_t>::difference_type>(common), b.end());
+  trim();
   return *this;
 }
 
 mtmath::ByteArray& mtmath::ByteArray::operator^=(const std::vector<uint8_t> &b) noexcept {
-  if (bytes.size() < b.size()) {
-    bytes.resize(b.size());
+  auto common = std::min(bytes.size(), b.size());
+  kernels().xor_bytes(bytes.data(), b.data(), common);
+  grow(std::max(bytes.size(), b.size()));
+  bytes.insert(bytes.end(), b.begin() + static_cast<std::vector<uint8_t>::difference_type>(common), b.end());
+  trim();
+  return *this;
+}
+
+void mtmath::ByteArray::trim() noexcept {
+  // Shrinking never reallocates, so the storage is kept for the next operation
+  bytes.resize(significant_size(bytes.data(), bytes.size()));
+}
+
+void mtmath::ByteArray::shrink() {
+  trim();
+  bytes.shrink_to_fit();
+}
+
+void mtmath::ByteArray::grow(size_t size) {
+  if (size > bytes.capacity()) {
+    bytes.reserve(std::max(size, bytes.capacity() * 2));
+  }
+}
+static constexpr ptrdiff_t WORD_BYTES = sizeof(uint64_t);
+
+// Little-endian word from bytes [index, index + 8) of src, reading zeros outside [0, size)
+static uint64_t load_word(const uint8_t *src, size_t size, ptrdiff_t index) noexcept {
+  if (index >= 0 && static_cast<size_t>(index + WORD_BYTES) <= size) {
+    return load_le(src + index);
   }
-  for (size_t i = 0; i < b.size() && i < bytes.size(); ++i) {
-    bytes[i] ^= b[i];
+  uint64_t word = 0;
+  for (ptrdiff_t i = 0; i < WORD_BYTES; ++i) {
+    auto at = index + i;
+    if (at >= 0 && static_cast<size_t>(at) < size) {
+      word |= static_cast<uint64_t>(src[at]) << (8 * i);
+    }
   }
-  simplify();
-  return *this;
+  return word;
 }
 
-void mtmath::ByteArray::simplify() {
-  for (size_t i = bytes.size(); i > 0; --i) {
-    if (bytes.at(i - 1) != 0) {
-      if (i != bytes.size()) {
-        bytes.erase(bytes.begin() + static_cast<std::vector<uint8_t>::difference_type>(i), bytes.end());
-        bytes.shrink_to_fit();
-      }
-      return;
+static uint8_t load_byte(const uint8_t *src, size_t size, ptrdiff_t index) noexcept {
+  return index >= 0 && static_cast<size_t>(index) < size ? src[index] : 0;
+}
+
+// Writes word to bytes [index, index + 8) of dst, dropping the bytes outside [0, size)
+static void store_word(uint8_t *dst, size_t size, ptrdiff_t index, uint64_t word) noexcept {
+  if (index >= 0 && static_cast<size_t>(index + WORD_BYTES) <= size) {
+    store_le(dst + index, word);
+    return;
+  }
+  for (ptrdiff_t i = 0; i < WORD_BYTES; ++i) {
+    auto at = index + i;
+    if (at >= 0 && static_cast<size_t>(at) < size) {
+      dst[at] = static_cast<uint8_t>(word >> (8 * i));
     }
   }
 }
+
+// Size of src << amount, without the top byte when the bits shifted into it are all zero
+static size_t shifted_left_size(const uint8_t *src, size_t size, size_t amount) noexcept {
+  auto bitShift = amount % 8;
+  auto carry = bitShift && size ? src[size - 1] >> (8 - bitShift) : 0;
+  return size + amount / 8 + (carry ? 1 : 0);
+}
+
+// dst[0, outSize) = src[0, size) << amount. Words are written from the top down, each reading only bytes at or
+// below the ones it writes, so dst may be src (with room for outSize bytes)
+static void shift_left(uint8_t *dst, size_t outSize, const uint8_t *src, size_t size, size_t amount) noexcept {
+  auto byteShift = static_cast<ptrdiff_t>(amount / 8);
+  auto bitShift = static_cast<unsigned>(amount % 8);
+  auto top = static_cast<ptrdiff_t>(outSize);
+  for (auto k = top - WORD_BYTES; k + WORD_BYTES > byteShift; k -= WORD_BYTES) {
+    auto word = load_word(src, size, k - byteShift);
+    if (bitShift) {
+      // Funnel in the top bits of the byte below the word
+      word = (word << bitShift) | (load_byte(src, size, k - byteShift - 1) >> (8 - bitShift));
+    }
+    store_word(dst, outSize, k, word);
+  }
+  if (byteShift) {
+    memset(dst, 0, static_cast<size_t>(byteShift));
+  }
+}
+
+// dst[0, outSize) = src[0, size) >> amount with outSize = size - amount / 8. Words are written from the bottom up,
+// each reading only bytes at or above the ones it writes, so dst may be src
+static void shift_right(uint8_t *dst, size_t outSize, const uint8_t *src, size_t size, size_t amount) noexcept {
+  auto byteShift = static_cast<ptrdiff_t>(amount / 8);
+  auto bitShift = static_cast<unsigned>(amount % 8);
+  for (ptrdiff_t k = 0; k < static_cast<ptrdiff_t>(outSize); k += WORD_BYTES) {
+    auto word = load_word(src, size, k + byteShift);
+    if (bitShift) {
+      // Funnel in the low bits of the byte above the word
+      word = (word >> bitShift) | (static_cast<uint64_t>(load_byte(src, size, k + byteShift + WORD_BYTES)) << (64 - bitShift));
+    }
+    store_word(dst, outSize, k, word);
+  }
+}
+
 mtmath::ByteArray mtmath::ByteArray::operator<<(size_t amount) const {
-  auto copy = *this;
-  copy <<= amount;
-  return copy;
+  auto res = ByteArray{};
+  shift_left_into(amount, res);
+  return res;
 }
+
 mtmath::ByteArray mtmath::ByteArray::operator>>(size_t amount) const {
-  auto copy = *this;
-  copy >>= amount;
-  return copy;
+  auto res = ByteArray{};
+  shift_right_into(amount, res);
+  return res;
 }
 
 mtmath::ByteArray& mtmath::ByteArray::operator<<=(size_t amount) {
-  // Doing right shifts since we store bits backwards
+  // Left shifts move bits to higher indices since we store bits backwards
   // (makes mem copying on little endian systems more efficient)
-  size_t numBytesToShift = amount / 8;
-  size_t numInnerShifts = amount % 8;
-
-  if (numBytesToShift) {
-    bytes.insert(bytes.begin(), numBytesToShift, 0x00U);
-  }
-
-  if (numInnerShifts) {
-    uint8_t carry = 0;
-    uint8_t carryShift = 8 - numInnerShifts;
-    uint8_t carryMask = (0xffU << carryShift);// rotate off the bits we aren't carrying over
-    for (auto &byte: bytes) {
-      auto newCarry = (byte & carryMask) >> carryShift;
-      byte <<= numInnerShifts;
-      byte |= carry;
-      carry = newCarry;
-    }
-    if (carry) {
-      bytes.emplace_back(carry);
-    }
+  if (bytes.empty()) {
+    // Zero stays zero, and padding it with zero bytes would grow storage that is never given back
+    return *this;
   }
+  auto size = bytes.size();
+  auto outSize = shifted_left_size(bytes.data(), size, amount);
+  // Grows at the back, so nothing is moved to make room before shifting
+  resize(outSize);
+  shift_left(bytes.data(), outSize, bytes.data(), size, amount);
   return *this;
 }
 
 mtmath::ByteArray& mtmath::ByteArray::operator>>=(size_t amount) {
-  // Doing right shifts since we store bits backwards
-  // (makes mem copying on little endian systems more efficient)
-  size_t numBytesToShift = amount / 8;
-  size_t numInnerShifts = amount % 8;
+  auto size = bytes.size();
+  auto outSize = amount / 8 < size ? size - amount / 8 : 0;
+  shift_right(bytes.data(), outSize, bytes.data(), size, amount);
+  bytes.resize(outSize);
+  return *this;
+}
 
-  if (numInnerShifts) {
-    uint8_t carry = 0;
-    uint8_t carryShift = 8 - numInnerShifts;
-    uint8_t carryMask = ~(0xffU << numInnerShifts);// rotate off the bits we aren't carrying over
-    for (auto iter = bytes.rbegin(); iter != bytes.rend(); ++iter) {
-      auto newCarry = ((*iter) & carryMask) << carryShift;
-      (*iter) >>= numInnerShifts;
-      (*iter) |= carry;
-      carry = newCarry;
-    }
+void mtmath::ByteArray::shift_left_into(size_t amount, mtmath::ByteArray &dest) const {
+  if (&dest == this) {
+    dest <<= amount;
+    return;
   }
+  if (bytes.empty()) {
+    dest.clear();
+    return;
+  }
+  auto outSize = shifted_left_size(bytes.data(), bytes.size(), amount);
+  dest.resize(outSize);
+  shift_left(dest.bytes.data(), outSize, bytes.data(), bytes.size(), amount);
+}
 
-  if (numBytesToShift) {
-    if (numBytesToShift >= bytes.size()) {
-      bytes.clear();
-    }
-    else {
-      bytes.end() = bytes.erase(bytes.begin(), bytes.begin() + numBytesToShift);
-    }
+void mtmath::ByteArray::shift_right_into(size_t amount, mtmath::ByteArray &dest) const {
+  if (&dest == this) {
+    dest >>= amount;
+    return;
   }
-  return *this;
+  auto outSize = amount / 8 < bytes.size() ? bytes.size() - amount / 8 : 0;
+  dest.resize(outSize);
+  shift_right(dest.bytes.data(), outSize, bytes.data(), bytes.size(), amount);
 }
@@ -1,16 +1,32 @@
 #pragma once
 
+#include <algorithm>
 #include <bit>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <compare>
 
 namespace mtmath {
+  /** Instruction sets ByteArray's bitwise and comparison kernels can use, from slowest to fastest */
+  enum class SimdLevel : uint8_t {
+    SCALAR,
+    SSE2,
+    AVX2,
+    AVX512
+  };
+
+  /**
+   * Little-endian bytes of a number. Storage grows geometrically and is never given back implicitly, so values
+   * which shrink and grow again (as in subtraction and gcd loops) reuse it. Call shrink() to release it
+   */
   class ByteArray {
     std::vector<uint8_t> bytes;
   public:
     ByteArray() = default;
     explicit ByteArray(std::vector<uint8_t> bytes) : bytes(std::move(bytes)) {}
 
+    /** Orders by the little-endian numbers the bytes hold, so leading zero bytes are ignored */
     [[nodiscard]] int compare(const std::vector<uint8_t>& b) const noexcept;
     [[nodiscard]] int compare(const ByteArray& o) const noexcept { return compare(o.bytes); }
 
@@ -32,21 +48,31 @@ namespace mtmath {
     ByteArray& operator<<=(size_t amount);
     ByteArray operator>>(size_t amount) const;
     ByteArray& operator>>=(size_t amount);
+    /**
+     * Writes this shifted into dest, reusing dest's storage, so shifting into a scratch array in a loop does not
+     * allocate. Shifts move whole words at a time, funnelling bits across word boundaries
+     */
+    void shift_left_into(size_t amount, ByteArray& dest) const;
+    void shift_right_into(size_t amount, ByteArray& dest) const;
 
     [[nodiscard]] std::strong_ordering operator<=>(const ByteArray& o) const noexcept;
     bool operator==(const ByteArray& o) const noexcept { return *this <=> o == std::strong_ordering::equal; }
 
-    uint8_t& operator[](size_t i) { return at(i); }
-    const uint8_t& operator[](size_t i) const noexcept { return at(i); }
+    /** Unchecked like std::vector, for hot loops. Use at() for range checked access */
+    uint8_t& operator[](size_t i) noexcept { return bytes[i]; }
+    const uint8_t& operator[](size_t i) const noexcept { return bytes[i]; }
     uint8_t& at(size_t i) { return bytes.at(i); }
     const uint8_t& at(size_t i) const { return bytes.at(i); }
 
-    uint8_t get(size_t i) const { return i < bytes.size() ? bytes.at(i) : 0U; }
+    uint8_t get(size_t i) const noexcept { return i < bytes.size() ? bytes[i] : 0U; }
 
     ByteArray& emplace_back(uint8_t byte) { bytes.emplace_back(byte); return *this; }
     ByteArray& reserve(size_t size) { bytes.reserve(size); return *this; }
-    ByteArray& resize(size_t size) { bytes.resize(size); return *this; }
+    ByteArray& resize(size_t size) { grow(size); bytes.resize(size); return *this; }
     size_t size() const noexcept { return bytes.size(); }
+    size_t capacity() const noexcept { return bytes.capacity(); }
+    const uint8_t* data() const noexcept { return bytes.data(); }
+    uint8_t* data() noexcept { return bytes.data(); }
     decltype(auto) begin() const { return bytes.begin(); }
     decltype(auto) begin() { return bytes.begin(); }
     decltype(auto) end() const { return bytes.end(); }
@@ -56,7 +82,18 @@ namespace mtmath {
       std::fill(begin, end, 0);
       simplify();
     }
-    void simplify();
+    /** Drops leading zero bytes, keeping the storage */
+    void simplify() noexcept { trim(); }
+    /** Drops leading zero bytes and gives back any storage they leave unused */
+    void shrink();
+
+    /** Kernels picked for this CPU the first time they are needed */
+    static SimdLevel simd_level() noexcept;
+    /**
+     * Switches every ByteArray to the kernels for level, capped at what the CPU supports, and returns the level
+     * now in use. Meant for tests and benchmarks
+     */
+    static SimdLevel set_simd_level(SimdLevel level) noexcept;
 
     void clear() {
       bytes.clear();
@@ -90,5 +127,11 @@ namespace mtmath {
       res.simplify();
       return res;
     }
+
+  private:
+    // Drops leading zero bytes without giving back the storage
+    void trim() noexcept;
+    // Makes room for size bytes, at least doubling the storage when it has to reallocate
+    void grow(size_t size);
   };
 }
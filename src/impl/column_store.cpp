@@ -0,0 +1,212 @@
+#include "column_store.h"
+#include <array>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MTMATH_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static constexpr std::array<char, 8> MAGIC = {'M', 'T', 'M', 'C', 'O', 'L', '\0', '\0'};
+static constexpr uint32_t FORMAT_VERSION = 1;
+// Magic, version, kind and count
+static constexpr size_t HEADER_SIZE = 24;
+
+static uint64_t read_le(const std::byte *bytes, size_t size) {
+  uint64_t res = 0;
+  for (size_t i = 0; i < size; ++i) {
+    res |= static_cast<uint64_t>(std::to_integer<uint8_t>(bytes[i])) << (8 * i);
+  }
+  return res;
+}
+
+static void write_le(std::ostream &out, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    out.put(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+void mtmath::ColumnWriter::push_back(const mtmath::BigInt &value) {
+  if (m_kind != ColumnKind::BIG_INT) {
+    throw std::invalid_argument("BigInt values can only be added to a BIG_INT column");
+  }
+  auto offset = m_data.size();
+  m_data.resize(offset + value.serialized_size());
+  value.serialize(std::span{m_data}.subspan(offset));
+  m_offsets.push_back(m_data.size());
+}
+
+void mtmath::ColumnWriter::push_back(const mtmath::Rational &value) {
+  if (m_kind != ColumnKind::RATIONAL) {
+    throw std::invalid_argument("Rational values can only be added to a RATIONAL column");
+  }
+  auto offset = m_data.size();
+  m_data.resize(offset + value.serialized_size());
+  value.serialize(std::span{m_data}.subspan(offset));
+  m_offsets.push_back(m_data.size());
+}
+
+bool mtmath::ColumnWriter::write(const std::string &path) const {
+  auto out = std::ofstream{path, std::ios::binary | std::ios::trunc};
+  if (!out) {
+    return false;
+  }
+  out.write(MAGIC.data(), MAGIC.size());
+  write_le(out, FORMAT_VERSION, sizeof(uint32_t));
+  write_le(out, static_cast<uint32_t>(m_kind), sizeof(uint32_t));
+  write_le(out, size(), sizeof(uint64_t));
+  for (auto offset : m_offsets) {
+    write_le(out, offset, sizeof(uint64_t));
+  }
+  out.write(reinterpret_cast<const char *>(m_data.data()), static_cast<std::streamsize>(m_data.size()));
+  return static_cast<bool>(out.flush());
+}
+
+std::optional<mtmath::MappedColumn> mtmath::MappedColumn::open(const std::string &path) {
+  auto column = MappedColumn{};
+#ifdef MTMATH_HAS_MMAP
+  auto fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  struct stat info{};
+  if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < HEADER_SIZE) {
+    ::close(fd);
+    return std::nullopt;
+  }
+  auto length = static_cast<size_t>(info.st_size);
+  auto mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    return std::nullopt;
+  }
+  column.m_mapping = static_cast<const std::byte *>(mapping);
+  column.m_length = length;
+#else
+  auto in = std::ifstream{path, std::ios::binary | std::ios::ate};
+  if (!in) {
+    return std::nullopt;
+  }
+  column.m_fallback.resize(static_cast<size_t>(in.tellg()));
+  in.seekg(0);
+  if (!in.read(reinterpret_cast<char *>(column.m_fallback.data()), static_cast<std::streamsize>(column.m_fallback.size()))) {
+    return std::nullopt;
+  }
+  column.m_mapping = column.m_fallback.data();
+  column.m_length = column.m_fallback.size();
+#endif
+
+  auto base = column.m_mapping;
+  if (column.m_length < HEADER_SIZE || !std::equal(MAGIC.begin(), MAGIC.end(), reinterpret_cast<const char *>(base))) {
+    return std::nullopt;
+  }
+  auto version = read_le(base + 8, sizeof(uint32_t));
+  auto kind = read_le(base + 12, sizeof(uint32_t));
+  auto count = read_le(base + 16, sizeof(uint64_t));
+  if (version != FORMAT_VERSION || (kind != static_cast<uint32_t>(ColumnKind::BIG_INT) && kind != static_cast<uint32_t>(ColumnKind::RATIONAL))) {
+    return std::nullopt;
+  }
+  // Divide rather than multiply so a corrupt count cannot overflow
+  auto available = column.m_length - HEADER_SIZE;
+  if (count >= available / sizeof(uint64_t)) {
+    return std::nullopt;
+  }
+  auto indexSize = (count + 1) * sizeof(uint64_t);
+  column.m_kind = static_cast<ColumnKind>(kind);
+  column.m_count = static_cast<size_t>(count);
+  column.m_index = base + HEADER_SIZE;
+  column.m_data = std::span{base + HEADER_SIZE + indexSize, available - indexSize};
+
+  // Offsets must start at zero, never decrease and stay inside the data, so bytes() needs no checks
+  uint64_t previous = 0;
+  for (size_t i = 0; i <= column.m_count; ++i) {
+    auto offset = read_le(column.m_index + i * sizeof(uint64_t), sizeof(uint64_t));
+    if ((i == 0 && offset != 0) || offset < previous || offset > column.m_data.size()) {
+      return std::nullopt;
+    }
+    previous = offset;
+  }
+  return column;
+}
+
+mtmath::MappedColumn::MappedColumn(mtmath::MappedColumn &&other) noexcept
+    : m_mapping(other.m_mapping),
+      m_length(other.m_length),
+      m_fallback(std::move(other.m_fallback)),
+      m_kind(other.m_kind),
+      m_count(other.m_count),
+      m_index(other.m_index),
+      m_data(other.m_data) {
+  other.m_mapping = nullptr;
+  other.m_length = 0;
+  other.m_count = 0;
+}
+
+mtmath::MappedColumn &mtmath::MappedColumn::operator=(mtmath::MappedColumn &&other) noexcept {
+  if (this != &other) {
+    release();
+    m_mapping = other.m_mapping;
+    m_length = other.m_length;
+    m_fallback = std::move(other.m_fallback);
+    m_kind = other.m_kind;
+    m_count = other.m_count;
+    m_index = other.m_index;
+    m_data = other.m_data;
+    other.m_mapping = nullptr;
+    other.m_length = 0;
+    other.m_count = 0;
+  }
+  return *this;
+}
+
+mtmath::MappedColumn::~MappedColumn() {
+  release();
+}
+
+void mtmath::MappedColumn::release() noexcept {
+#ifdef MTMATH_HAS_MMAP
+  if (m_mapping) {
+    ::munmap(const_cast<std::byte *>(m_mapping), m_length);
+  }
+#endif
+  m_mapping = nullptr;
+  m_length = 0;
+  m_fallback.clear();
+}
+
+std::span<const std::byte> mtmath::MappedColumn::bytes(size_t index) const noexcept {
+  auto begin = read_le(m_index + index * sizeof(uint64_t), sizeof(uint64_t));
+  auto end = read_le(m_index + (index + 1) * sizeof(uint64_t), sizeof(uint64_t));
+  return m_data.subspan(begin, end - begin);
+}
+
+std::optional<mtmath::BigIntView> mtmath::MappedColumn::big_int(size_t index) const noexcept {
+  if (m_kind != ColumnKind::BIG_INT || index >= m_count) {
+    return std::nullopt;
+  }
+  auto value = bytes(index);
+  size_t consumed = 0;
+  auto view = mtmath::BigIntView::deserialize(value, &consumed);
+  if (!view || consumed != value.size()) {
+    return std::nullopt;
+  }
+  return view;
+}
+
+std::optional<mtmath::RationalView> mtmath::MappedColumn::rational(size_t index) const noexcept {
+  if (m_kind != ColumnKind::RATIONAL || index >= m_count) {
+    return std::nullopt;
+  }
+  auto value = bytes(index);
+  size_t consumed = 0;
+  auto view = mtmath::RationalView::deserialize(value, &consumed);
+  if (!view || consumed != value.size()) {
+    return std::nullopt;
+  }
+  return view;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "rational.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace mtmath {
+  /** What the values in a column file are */
+  enum class ColumnKind : uint32_t {
+    BIG_INT = 1,
+    RATIONAL = 2
+  };
+
+  /**
+   * Builds a column file: a header with the kind and count, an index of count + 1 little-endian offsets, then the
+   * serialized values back to back. Value i is the bytes between offsets i and i + 1
+   */
+  class ColumnWriter {
+  public:
+    explicit ColumnWriter(ColumnKind kind) : m_kind(kind), m_offsets{0} {}
+
+    [[nodiscard]] ColumnKind kind() const noexcept { return m_kind; }
+    [[nodiscard]] size_t size() const noexcept { return m_offsets.size() - 1; }
+
+    /** Throws std::invalid_argument if the column is not a BIG_INT column */
+    void push_back(const mtmath::BigInt& value);
+    /** Throws std::invalid_argument if the column is not a RATIONAL column */
+    void push_back(const mtmath::Rational& value);
+
+    /** Writes the whole column to path, replacing any file there. False if the file could not be written */
+    [[nodiscard]] bool write(const std::string& path) const;
+
+  private:
+    ColumnKind m_kind;
+    std::vector<uint64_t> m_offsets;
+    std::vector<std::byte> m_data = {};
+  };
+
+  /**
+   * Read-only column file mapped into memory. Values are handed out as views into the mapping, so scanning a
+   * column never copies a value unless the caller turns a view into a BigInt or Rational.
+   * Only the header and index are checked when opening, each value is checked when it is viewed
+   */
+  class MappedColumn {
+  public:
+    /** Empty if the file cannot be read or its header or index is malformed */
+    static std::optional<MappedColumn> open(const std::string& path);
+
+    MappedColumn(const MappedColumn& other) = delete;
+    MappedColumn(MappedColumn&& other) noexcept;
+    MappedColumn& operator=(const MappedColumn& other) = delete;
+    MappedColumn& operator=(MappedColumn&& other) noexcept;
+    ~MappedColumn();
+
+    [[nodiscard]] ColumnKind kind() const noexcept { return m_kind; }
+    [[nodiscard]] size_t size() const noexcept { return m_count; }
+
+    /** Serialized bytes of value i. Index must be below size() */
+    [[nodiscard]] std::span<const std::byte> bytes(size_t index) const noexcept;
+    /** Value i of a BIG_INT column. Empty if index is not below size(), the value is malformed or this is not a BIG_INT column */
+    [[nodiscard]] std::optional<mtmath::BigIntView> big_int(size_t index) const noexcept;
+    /** Value i of a RATIONAL column. Empty if index is not below size(), the value is malformed or this is not a RATIONAL column */
+    [[nodiscard]] std::optional<mtmath::RationalView> rational(size_t index) const noexcept;
+
+  private:
+    MappedColumn() = default;
+    void release() noexcept;
+
+    const std::byte* m_mapping = nullptr;
+    size_t m_length = 0;
+    // Holds the file contents where memory mapping is not available
+    std::vector<std::byte> m_fallback = {};
+    ColumnKind m_kind = ColumnKind::BIG_INT;
+    size_t m_count = 0;
+    const std::byte* m_index = nullptr;
+    std::span<const std::byte> m_data = {};
+  };
+}
@@ -0,0 +1,128 @@
+#include "dyadic.h"
+#include <cmath>
+
+mtmath::Dyadic::Dyadic(mtmath::BigInt mantissa, int64_t exponent) : m_mantissa(std::move(mantissa)), m_exponent(exponent) {
+  normalize();
+}
+
+void mtmath::Dyadic::normalize() {
+  if (!m_mantissa.is_valid() || m_mantissa.is_zero()) {
+    m_exponent = 0;
+    return;
+  }
+  auto zeros = m_mantissa.trailing_zeros();
+  if (zeros) {
+    m_mantissa >>= zeros;
+    m_exponent += static_cast<int64_t>(zeros);
+  }
+}
+
+mtmath::Dyadic mtmath::Dyadic::from_double(double value) {
+  if (!std::isfinite(value)) {
+    return Dyadic{mtmath::BigInt::invalid()};
+  }
+  auto [negative, mantissa, exponent] = split_double(value);
+  auto res = Dyadic{};
+  res.m_mantissa = mtmath::BigInt{mantissa};
+  res.m_exponent = mantissa == 0 ? 0 : exponent;
+  if (negative) {
+    res.m_mantissa = -res.m_mantissa;
+  }
+  return res;
+}
+
+std::optional<mtmath::Dyadic> mtmath::Dyadic::from_rational(const mtmath::Rational &r) {
+  if (!r.is_finite()) {
+    return std::nullopt;
+  }
+  const auto &denominator = r.denominator();
+  auto zeros = denominator.trailing_zeros();
+  // A power of two is the only positive number whose lowest set bit is also its highest
+  if (denominator.bit_length() != zeros + 1) {
+    return std::nullopt;
+  }
+  return Dyadic{r.numerator(), -static_cast<int64_t>(zeros)};
+}
+
+double mtmath::Dyadic::to_double() const noexcept {
+  return m_mantissa.to_double(m_exponent);
+}
+
+mtmath::Rational mtmath::Dyadic::to_rational() const {
+  if (!is_valid()) {
+    return std::numeric_limits<mtmath::Rational>::quiet_NaN();
+  }
+  if (m_exponent >= 0) {
+    return mtmath::Rational{m_mantissa << static_cast<size_t>(m_exponent), mtmath::BigInt::one(), mtmath::Rational::Reduced{}};
+  }
+  return mtmath::Rational{m_mantissa, mtmath::BigInt::one() << static_cast<size_t>(-m_exponent), mtmath::Rational::Reduced{}};
+}
+
+std::strong_ordering mtmath::Dyadic::operator<=>(const mtmath::Dyadic &o) const noexcept {
+  if (!is_valid() || !o.is_valid()) {
+    return m_mantissa <=> o.m_mantissa;
+  }
+  auto sign = is_zero() ? 0 : (is_negative() ? -1 : 1);
+  auto otherSign = o.is_zero() ? 0 : (o.is_negative() ? -1 : 1);
+  if (sign != otherSign || sign == 0) {
+    return sign <=> otherSign;
+  }
+  // The leading bit positions settle it unless they match, in which case the shift below is bounded
+  auto top = static_cast<int64_t>(m_mantissa.bit_length()) + m_exponent;
+  auto otherTop = static_cast<int64_t>(o.m_mantissa.bit_length()) + o.m_exponent;
+  if (top != otherTop) {
+    return sign < 0 ? otherTop <=> top : top <=> otherTop;
+  }
+  if (m_exponent > o.m_exponent) {
+    return (m_mantissa << static_cast<size_t>(m_exponent - o.m_exponent)) <=> o.m_mantissa;
+  }
+  return m_mantissa <=> (o.m_mantissa << static_cast<size_t>(o.m_exponent - m_exponent));
+}
+
+mtmath::Dyadic mtmath::Dyadic::operator-() const {
+  auto res = *this;
+  res.m_mantissa = -m_mantissa;
+  return res;
+}
+
+mtmath::Dyadic &mtmath::Dyadic::operator+=(const mtmath::Dyadic &o) {
+  if (o.is_zero() && o.is_valid()) {
+    return *this;
+  }
+  else if (is_zero() && is_valid()) {
+    return *this = o;
+  }
+  // Align to the smaller exponent; only the sum of two equally aligned odd mantissas can leave trailing zeros
+  if (m_exponent > o.m_exponent) {
+    m_mantissa <<= static_cast<size_t>(m_exponent - o.m_exponent);
+    m_exponent = o.m_exponent;
+    m_mantissa += o.m_mantissa;
+  }
+  else {
+    m_mantissa += o.m_mantissa << static_cast<size_t>(o.m_exponent - m_exponent);
+  }
+  normalize();
+  return *this;
+}
+
+mtmath::Dyadic &mtmath::Dyadic::operator-=(const mtmath::Dyadic &o) {
+  return *this += -o;
+}
+
+mtmath::Dyadic &mtmath::Dyadic::operator*=(const mtmath::Dyadic &o) {
+  // The product of odd mantissas is odd, so the result stays normalized
+  m_mantissa *= o.m_mantissa;
+  m_exponent += o.m_exponent;
+  if (m_mantissa.is_zero() || !m_mantissa.is_valid()) {
+    m_exponent = 0;
+  }
+  return *this;
+}
+
+mtmath::Dyadic mtmath::Dyadic::ldexp(int64_t shift) const {
+  auto res = *this;
+  if (!res.is_zero()) {
+    res.m_exponent += shift;
+  }
+  return res;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "rational.h"
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+
+namespace mtmath {
+  /**
+   * Exact number of the form mantissa * 2^exponent. Covers every value which comes from binary floating point.
+   * Addition and multiplication only shift, and normalizing just strips trailing zero bits from the mantissa,
+   * so no gcd is ever needed. Converts to and from Rational
+   */
+  class Dyadic {
+  public:
+    Dyadic(mtmath::BigInt mantissa, int64_t exponent = 0);
+    Dyadic() = default;
+    Dyadic(const Dyadic& other) = default;
+    Dyadic(Dyadic&& other) noexcept = default;
+    Dyadic& operator=(const Dyadic& other) = default;
+    Dyadic& operator=(Dyadic&& other) noexcept = default;
+
+    /** Exact value of a double. Invalid for NaN and infinities */
+    static Dyadic from_double(double value);
+    /** The value if its denominator is a power of two */
+    static std::optional<Dyadic> from_rational(const mtmath::Rational& r);
+
+    /** Odd unless the value is zero */
+    [[nodiscard]] const mtmath::BigInt& mantissa() const noexcept { return m_mantissa; }
+    [[nodiscard]] int64_t exponent() const noexcept { return m_exponent; }
+    [[nodiscard]] bool is_valid() const noexcept { return m_mantissa.is_valid(); }
+    [[nodiscard]] bool is_zero() const noexcept { return m_mantissa.is_zero(); }
+    [[nodiscard]] bool is_negative() const noexcept { return m_mantissa.is_negative(); }
+
+    /** Nearest double (ties to even) */
+    [[nodiscard]] double to_double() const noexcept;
+    /** Already in lowest terms, so no gcd is needed */
+    [[nodiscard]] mtmath::Rational to_rational() const;
+
+    [[nodiscard]] std::strong_ordering operator<=>(const Dyadic& o) const noexcept;
+    [[nodiscard]] bool operator==(const Dyadic& o) const noexcept {
+      return m_exponent == o.m_exponent && m_mantissa == o.m_mantissa;
+    }
+
+    Dyadic operator-() const;
+    Dyadic& operator+=(const Dyadic& o);
+    Dyadic& operator-=(const Dyadic& o);
+    Dyadic& operator*=(const Dyadic& o);
+    Dyadic operator+(const Dyadic& o) const { auto copy = *this; return copy += o; }
+    Dyadic operator-(const Dyadic& o) const { auto copy = *this; return copy -= o; }
+    Dyadic operator*(const Dyadic& o) const { auto copy = *this; return copy *= o; }
+    /** Multiplies by 2^shift */
+    Dyadic ldexp(int64_t shift) const;
+
+    friend std::ostream& operator<<(std::ostream& o, const Dyadic& d) {
+      o << d.m_mantissa << "*2^" << d.m_exponent;
+      return o;
+    }
+
+  private:
+    mtmath::BigInt m_mantissa = {};
+    int64_t m_exponent = 0;
+
+    void normalize();
+  };
+}
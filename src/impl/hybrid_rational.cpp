@@ -0,0 +1,192 @@
+#include "hybrid_rational.h"
+#include <limits>
+#include <numeric>
+
+static constexpr __int128 SMALL_MAX = std::numeric_limits<int64_t>::max();
+
+static bool fits_small(__int128 v) noexcept {
+  return v >= -SMALL_MAX && v <= SMALL_MAX;
+}
+
+static uint64_t magnitude(__int128 v) noexcept {
+  return static_cast<uint64_t>(v < 0 ? -v : v);
+}
+
+static mtmath::BigInt to_big(__int128 v) {
+  auto mag = static_cast<unsigned __int128>(v < 0 ? -v : v);
+  auto res = (mtmath::BigInt{static_cast<uint64_t>(mag >> 64)} << 64) + mtmath::BigInt{static_cast<uint64_t>(mag)};
+  return v < 0 ? -res : res;
+}
+
+mtmath::HybridRational::HybridRational(int64_t numerator, int64_t denominator) noexcept {
+  __int128 n = numerator;
+  __int128 d = denominator;
+  if (d < 0) {
+    n = -n;
+    d = -d;
+  }
+  if (d == 0) {
+    num = n == 0 ? 0 : (n < 0 ? -1 : 1);
+    den = 0;
+    return;
+  }
+  auto g = std::gcd(magnitude(n), magnitude(d));
+  store(n / g, d / g);
+}
+
+mtmath::HybridRational::HybridRational(const mtmath::Rational &r) {
+  store(r);
+}
+
+void mtmath::HybridRational::store(__int128 n, __int128 d) {
+  if (fits_small(n) && fits_small(d)) {
+    num = static_cast<int64_t>(n);
+    den = static_cast<int64_t>(d);
+    big.reset();
+  }
+  else {
+    big = mtmath::Rational{to_big(n), to_big(d)};
+  }
+}
+
+void mtmath::HybridRational::store(mtmath::Rational r) {
+  if (!r.is_finite()) {
+    num = r.is_nan() ? 0 : (r.is_neg_infinity() ? -1 : 1);
+    den = 0;
+    big.reset();
+    return;
+  }
+  const auto &n = r.numerator();
+  const auto &d = r.denominator();
+  if (n.bit_length() < 64 && d.bit_length() < 64) {
+    num = n.as_i64();
+    den = d.as_i64();
+    big.reset();
+  }
+  else {
+    big = std::move(r);
+  }
+}
+
+template<typename Op>
+void mtmath::HybridRational::promoted_op(const HybridRational &other, Op op) {
+  auto res = to_rational();
+  op(res, other.to_rational());
+  store(std::move(res));
+}
+
+bool mtmath::HybridRational::is_nan() const noexcept {
+  return big ? big->is_nan() : den == 0 && num == 0;
+}
+
+bool mtmath::HybridRational::is_infinite() const noexcept {
+  return big ? big->is_infinite() : den == 0 && num != 0;
+}
+
+bool mtmath::HybridRational::is_pos_infinity() const noexcept {
+  return big ? big->is_pos_infinity() : den == 0 && num > 0;
+}
+
+bool mtmath::HybridRational::is_neg_infinity() const noexcept {
+  return big ? big->is_neg_infinity() : den == 0 && num < 0;
+}
+
+bool mtmath::HybridRational::is_finite() const noexcept {
+  return big ? big->is_finite() : den != 0;
+}
+
+std::strong_ordering mtmath::HybridRational::operator<=>(const HybridRational &o) const noexcept {
+  if (is_small() && o.is_small() && is_finite() && o.is_finite()) {
+    return static_cast<__int128>(num) * o.den <=> static_cast<__int128>(o.num) * den;
+  }
+  return to_rational() <=> o.to_rational();
+}
+
+bool mtmath::HybridRational::operator==(const HybridRational &o) const noexcept {
+  return ((*this) <=> o) == std::strong_ordering::equal;
+}
+
+mtmath::HybridRational mtmath::HybridRational::operator-() const noexcept {
+  auto res = *this;
+  if (big) {
+    res.big = -*big;
+  }
+  else {
+    res.num = -num;
+  }
+  return res;
+}
+
+mtmath::HybridRational &mtmath::HybridRational::operator+=(const HybridRational &other) noexcept {
+  if (!is_small() || !other.is_small() || !is_finite() || !other.is_finite()) {
+    promoted_op(other, [](mtmath::Rational &l, const mtmath::Rational &r) { l += r; });
+    return *this;
+  }
+
+  // Henrici's addition with 128-bit intermediates, which cannot overflow for 64-bit parts
+  auto d1 = static_cast<int64_t>(std::gcd(den, other.den));
+  if (d1 == 1) {
+    store(static_cast<__int128>(num) * other.den + static_cast<__int128>(other.num) * den,
+          static_cast<__int128>(den) * other.den);
+    return *this;
+  }
+  auto ownPart = den / d1;
+  auto t = static_cast<__int128>(num) * (other.den / d1) + static_cast<__int128>(other.num) * ownPart;
+  if (t == 0) {
+    store(0, 1);
+    return *this;
+  }
+  auto d2 = static_cast<int64_t>(std::gcd(magnitude(t % d1), static_cast<uint64_t>(d1)));
+  store(t / d2, static_cast<__int128>(ownPart) * (other.den / d2));
+  return *this;
+}
+
+mtmath::HybridRational &mtmath::HybridRational::operator-=(const HybridRational &other) noexcept {
+  return *this += -other;
+}
+
+void mtmath::HybridRational::multiply(int64_t n, int64_t d) {
+  if (num == 0 || n == 0) {
+    store(0, 1);
+    return;
+  }
+  // Cross-cancel so the 128-bit products are already in lowest terms
+  auto d1 = std::gcd(num, d);
+  auto d2 = std::gcd(den, n);
+  store(static_cast<__int128>(num / d1) * (n / d2), static_cast<__int128>(den / d2) * (d / d1));
+}
+
+mtmath::HybridRational &mtmath::HybridRational::operator*=(const HybridRational &other) noexcept {
+  if (!is_small() || !other.is_small() || !is_finite() || !other.is_finite()) {
+    promoted_op(other, [](mtmath::Rational &l, const mtmath::Rational &r) { l *= r; });
+    return *this;
+  }
+  multiply(other.num, other.den);
+  return *this;
+}
+
+mtmath::HybridRational &mtmath::HybridRational::operator/=(const HybridRational &other) noexcept {
+  if (!is_small() || !other.is_small() || !is_finite() || !other.is_finite() || other.num == 0) {
+    promoted_op(other, [](mtmath::Rational &l, const mtmath::Rational &r) { l /= r; });
+    return *this;
+  }
+  if (other.num < 0) {
+    multiply(-other.den, -other.num);
+  }
+  else {
+    multiply(other.den, other.num);
+  }
+  return *this;
+}
+
+mtmath::BigInt mtmath::HybridRational::numerator() const {
+  return big ? big->numerator() : mtmath::BigInt{num};
+}
+
+mtmath::BigInt mtmath::HybridRational::denominator() const {
+  return big ? big->denominator() : mtmath::BigInt{den};
+}
+
+mtmath::Rational mtmath::HybridRational::to_rational() const {
+  return big ? *big : mtmath::Rational{mtmath::BigInt{num}, mtmath::BigInt{den}};
+}
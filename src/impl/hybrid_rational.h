@@ -0,0 +1,75 @@
+#pragma once
+
+#include "rational.h"
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+
+namespace mtmath {
+  /**
+   * Rational number stored in int64_t parts while it fits. Arithmetic is done in 128 bits and the result is
+   * promoted to a BigInt backed Rational only when it no longer fits in 64 bits. Results which fit again are
+   * demoted back to the small form.
+   */
+  class HybridRational {
+  public:
+    HybridRational(int64_t numerator, int64_t denominator = 1) noexcept;
+    explicit HybridRational(const mtmath::Rational& r);
+
+    HybridRational() = default;
+    HybridRational(const HybridRational& other) = default;
+    HybridRational(HybridRational&& other) noexcept = default;
+    HybridRational& operator=(const HybridRational& other) = default;
+    HybridRational& operator=(HybridRational&& other) noexcept = default;
+
+    /** Whether the value currently lives in the int64 form */
+    [[nodiscard]] bool is_small() const noexcept { return !big.has_value(); }
+
+    [[nodiscard]] bool is_nan() const noexcept;
+    [[nodiscard]] bool is_infinite() const noexcept;
+    [[nodiscard]] bool is_pos_infinity() const noexcept;
+    [[nodiscard]] bool is_neg_infinity() const noexcept;
+    [[nodiscard]] bool is_finite() const noexcept;
+    [[nodiscard]] std::strong_ordering operator<=>(const HybridRational& o) const noexcept;
+    [[nodiscard]] bool operator==(const HybridRational& o) const noexcept;
+
+    HybridRational operator-() const noexcept;
+
+    HybridRational& operator+=(const HybridRational& other) noexcept;
+    HybridRational& operator-=(const HybridRational& other) noexcept;
+    HybridRational& operator*=(const HybridRational& other) noexcept;
+    HybridRational& operator/=(const HybridRational& other) noexcept;
+    HybridRational operator+(const HybridRational& other) const noexcept { auto copy = *this; return copy += other; }
+    HybridRational operator-(const HybridRational& other) const noexcept { auto copy = *this; return copy -= other; }
+    HybridRational operator*(const HybridRational& other) const noexcept { auto copy = *this; return copy *= other; }
+    HybridRational operator/(const HybridRational& other) const noexcept { auto copy = *this; return copy /= other; }
+
+    [[nodiscard]] mtmath::BigInt numerator() const;
+    [[nodiscard]] mtmath::BigInt denominator() const;
+    [[nodiscard]] mtmath::Rational to_rational() const;
+
+    friend std::ostream& operator<<(std::ostream& o, const HybridRational& r) {
+      if (r.big) {
+        o << *r.big;
+      }
+      else {
+        o << r.num << "/" << r.den;
+      }
+      return o;
+    }
+
+  private:
+    // Small form, in lowest terms with den >= 0. INT64_MIN is never stored so negation cannot overflow
+    int64_t num = 0;
+    int64_t den = 1;
+    // Set once the value has been promoted
+    std::optional<mtmath::Rational> big = std::nullopt;
+
+    void store(__int128 n, __int128 d);
+    void store(mtmath::Rational r);
+    void multiply(int64_t n, int64_t d);
+    template<typename Op>
+    void promoted_op(const HybridRational& other, Op op);
+  };
+}
@@ -0,0 +1,858 @@
+#include "limbs.h"
+#include "byte_array.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+using mtmath::limbs::DoubleLimb;
+using mtmath::limbs::Limb;
+using mtmath::limbs::Limbs;
+
+static constexpr size_t LIMB_BITS = std::numeric_limits<Limb>::digits;
+
+static Limb load_le(const uint8_t *src) noexcept {
+  Limb word = 0;
+  if constexpr (std::endian::native == std::endian::little) {
+    memcpy(&word, src, sizeof(word));
+  }
+  else {
+    for (size_t i = 0; i < sizeof(word); ++i) {
+      word |= static_cast<Limb>(src[i]) << (8 * i);
+    }
+  }
+  return word;
+}
+
+static void store_le(uint8_t *dst, Limb word) noexcept {
+  if constexpr (std::endian::native == std::endian::little) {
+    memcpy(dst, &word, sizeof(word));
+  }
+  else {
+    for (size_t i = 0; i < sizeof(word); ++i) {
+      dst[i] = static_cast<uint8_t>(word >> (8 * i));
+    }
+  }
+}
+
+mtmath::limbs::Limbs mtmath::limbs::from_bytes(const ByteArray &bytes) {
+  return from_bytes(std::span<const uint8_t>{bytes.data(), bytes.size()});
+}
+
+mtmath::limbs::Limbs mtmath::limbs::from_bytes(std::span<const uint8_t> bytes) {
+  Limbs res((bytes.size() + sizeof(Limb) - 1) / sizeof(Limb), 0);
+  if constexpr (std::endian::native == std::endian::little) {
+    if (!bytes.empty()) {
+      memcpy(static_cast<void *>(res.data()), static_cast<const void *>(bytes.data()), bytes.size());
+    }
+  }
+  else {
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      res[i / sizeof(Limb)] |= static_cast<Limb>(bytes[i]) << (8 * (i % sizeof(Limb)));
+    }
+  }
+  trim(res);
+  return res;
+}
+
+mtmath::ByteArray mtmath::limbs::to_bytes(const Limbs &l) {
+  std::vector<uint8_t> bytes((bit_length(l) + 7) / 8);
+  if constexpr (std::endian::native == std::endian::little) {
+    if (!bytes.empty()) {
+      memcpy(static_cast<void *>(bytes.data()), static_cast<const void *>(l.data()), bytes.size());
+    }
+  }
+  else {
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      bytes[i] = static_cast<uint8_t>(l[i / sizeof(Limb)] >> (8 * (i % sizeof(Limb))));
+    }
+  }
+  return ByteArray{std::move(bytes)};
+}
+
+void mtmath::limbs::trim(Limbs &l) noexcept {
+  while (!l.empty() && l.back() == 0) {
+    l.pop_back();
+  }
+}
+
+size_t mtmath::limbs::bit_length(const Limbs &l) noexcept {
+  if (l.empty()) {
+    return 0;
+  }
+  return (l.size() - 1) * LIMB_BITS + static_cast<size_t>(std::bit_width(l.back()));
+}
+
+int mtmath::limbs::compare(const Limbs &a, const Limbs &b) noexcept {
+  if (a.size() != b.size()) {
+    return a.size() < b.size() ? -1 : 1;
+  }
+  for (size_t i = a.size(); i > 0; --i) {
+    if (a[i - 1] != b[i - 1]) {
+      return a[i - 1] < b[i - 1] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+mtmath::limbs::Limbs mtmath::limbs::add(const Limbs &a, const Limbs &b) {
+  const auto &bigger = a.size() >= b.size() ? a : b;
+  const auto &smaller = a.size() >= b.size() ? b : a;
+  Limbs res(bigger.size() + 1, 0);
+  Limb carry = 0;
+  for (size_t i = 0; i < bigger.size(); ++i) {
+    auto sum = static_cast<DoubleLimb>(bigger[i]) + (i < smaller.size() ? smaller[i] : 0) + carry;
+    res[i] = static_cast<Limb>(sum);
+    carry = static_cast<Limb>(sum >> LIMB_BITS);
+  }
+  res[bigger.size()] = carry;
+  trim(res);
+  return res;
+}
+
+mtmath::limbs::Limbs mtmath::limbs::sub(const Limbs &a, const Limbs &b) {
+  Limbs res(a.size(), 0);
+  Limb borrow = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    auto diff = static_cast<DoubleLimb>(a[i]) - (i < b.size() ? b[i] : 0) - borrow;
+    res[i] = static_cast<Limb>(diff);
+    borrow = static_cast<Limb>(diff >> LIMB_BITS) ? 1 : 0;
+  }
+  trim(res);
+  return res;
+}
+
+mtmath::limbs::Limb mtmath::limbs::add_bytes(uint8_t *dst, size_t n, const uint8_t *src, size_t m) noexcept {
+  Limb carry = 0;
+  size_t i = 0;
+  // Both words are loaded before the store, so src may be dst
+  for (; i + sizeof(Limb) <= m; i += sizeof(Limb)) {
+    auto sum = static_cast<DoubleLimb>(load_le(dst + i)) + load_le(src + i) + carry;
+    store_le(dst + i, static_cast<Limb>(sum));
+    carry = static_cast<Limb>(sum >> LIMB_BITS);
+  }
+  for (; i < m; ++i) {
+    auto sum = static_cast<Limb>(dst[i]) + src[i] + carry;
+    dst[i] = static_cast<uint8_t>(sum);
+    carry = sum >> 8;
+  }
+  for (; carry && i < n; ++i) {
+    ++dst[i];
+    carry = dst[i] == 0 ? 1 : 0;
+  }
+  return carry;
+}
+
+void mtmath::limbs::sub_bytes(uint8_t *dst, const uint8_t *a, size_t n, const uint8_t *b, size_t m) noexcept {
+  Limb borrow = 0;
+  size_t i = 0;
+  for (; i + sizeof(Limb) <= m; i += sizeof(Limb)) {
+    auto diff = static_cast<DoubleLimb>(load_le(a + i)) - load_le(b + i) - borrow;
+    store_le(dst + i, static_cast<Limb>(diff));
+    borrow = static_cast<Limb>(diff >> LIMB_BITS) ? 1 : 0;
+  }
+  for (; i < m; ++i) {
+    auto diff = static_cast<Limb>(a[i]) - b[i] - borrow;
+    dst[i] = static_cast<uint8_t>(diff);
+    borrow = diff >> 8 ? 1 : 0;
+  }
+  // Once the borrow is gone an in place subtraction has nothing left to write
+  for (; i < n && (borrow || dst != a); ++i) {
+    auto diff = static_cast<Limb>(a[i]) - borrow;
+    dst[i] = static_cast<uint8_t>(diff);
+    borrow = diff >> 8 ? 1 : 0;
+  }
+}
+
+int mtmath::limbs::compare_bytes(const uint8_t *a, const uint8_t *b, size_t n) noexcept {
+  // Little-endian loads make the first differing word compare the right way round
+  for (; n >= sizeof(Limb); n -= sizeof(Limb)) {
+    auto x = load_le(a + n - sizeof(Limb));
+    auto y = load_le(b + n - sizeof(Limb));
+    if (x != y) {
+      return x < y ? -1 : 1;
+    }
+  }
+  for (; n > 0; --n) {
+    if (a[n - 1] != b[n - 1]) {
+      return a[n - 1] < b[n - 1] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+void mtmath::limbs::mul_1_bytes(uint8_t *dst, size_t n, Limb b) noexcept {
+  Limb carry = 0;
+  for (size_t i = 0; i < n; i += sizeof(Limb)) {
+    auto t = static_cast<DoubleLimb>(load_le(dst + i)) * b + carry;
+    store_le(dst + i, static_cast<Limb>(t));
+    carry = static_cast<Limb>(t >> LIMB_BITS);
+  }
+  store_le(dst + n, carry);
+}
+
+// Single limb divisor shifted so its top bit is set, with the reciprocal floor((B^2 - 1) / d) - B
+struct WordDivisor {
+  Limb d;
+  Limb v;
+  unsigned shift;
+};
+
+static WordDivisor word_divisor(Limb d) noexcept {
+  auto shift = static_cast<unsigned>(std::countl_zero(d));
+  d <<= shift;
+  auto v = static_cast<Limb>(((static_cast<DoubleLimb>(~d) << LIMB_BITS) | ~Limb{0}) / d);
+  return WordDivisor{d, v, shift};
+}
+
+// Divides (r, u0) by the normalized divisor with a multiply instead of a hardware divide (Moller and Granlund).
+// Requires r < d; returns the quotient and leaves the remainder in r
+static Limb div_preinv(Limb &r, Limb u0, const WordDivisor &w) noexcept {
+  auto q = static_cast<DoubleLimb>(w.v) * r + ((static_cast<DoubleLimb>(r) << LIMB_BITS) | u0);
+  auto q1 = static_cast<Limb>(q >> LIMB_BITS) + 1;
+  auto q0 = static_cast<Limb>(q);
+  r = u0 - q1 * w.d;
+  if (r > q0) {
+    --q1;
+    r += w.d;
+  }
+  if (r >= w.d) {
+    ++q1;
+    r -= w.d;
+  }
+  return q1;
+}
+
+// Long division of k words by a single limb. Dividing the numerator shifted by the divisor's normalization gives
+// the same quotient and a shifted remainder, so the shift is applied to the words as they are read
+template<typename Load, typename Store>
+static Limb divrem_1(size_t k, Limb d, Load load, Store store) noexcept {
+  if (k == 0) {
+    return 0;
+  }
+  auto w = word_divisor(d);
+  auto cur = load(k - 1);
+  Limb r = w.shift ? cur >> (LIMB_BITS - w.shift) : 0;
+  for (size_t j = k; j > 0; --j) {
+    auto next = j > 1 ? load(j - 2) : 0;
+    auto u0 = w.shift ? (cur << w.shift) | (next >> (LIMB_BITS - w.shift)) : cur;
+    store(j - 1, div_preinv(r, u0, w));
+    cur = next;
+  }
+  return r >> w.shift;
+}
+
+mtmath::limbs::Limb mtmath::limbs::divrem_1_bytes(uint8_t *dst, size_t n, Limb d) noexcept {
+  return divrem_1(
+      n / sizeof(Limb), d,
+      [dst](size_t i) { return load_le(dst + i * sizeof(Limb)); },
+      [dst](size_t i, Limb q) { store_le(dst + i * sizeof(Limb), q); });
+}
+
+// Adds x into res starting at limb offset; res must be large enough to hold the sum
+static void add_into(Limbs &res, size_t offset, const Limbs &x) {
+  Limb carry = 0;
+  size_t i = 0;
+  for (; i < x.size(); ++i) {
+    auto sum = static_cast<DoubleLimb>(res[offset + i]) + x[i] + carry;
+    res[offset + i] = static_cast<Limb>(sum);
+    carry = static_cast<Limb>(sum >> LIMB_BITS);
+  }
+  for (; carry && offset + i < res.size(); ++i) {
+    res[offset + i] += carry;
+    carry = res[offset + i] == 0 ? 1 : 0;
+  }
+}
+
+// Subtracts x from res in place; requires res >= x
+static void sub_into(Limbs &res, const Limbs &x) {
+  Limb borrow = 0;
+  size_t i = 0;
+  for (; i < x.size(); ++i) {
+    auto diff = static_cast<DoubleLimb>(res[i]) - x[i] - borrow;
+    res[i] = static_cast<Limb>(diff);
+    borrow = static_cast<Limb>(diff >> LIMB_BITS) ? 1 : 0;
+  }
+  for (; borrow && i < res.size(); ++i) {
+    borrow = res[i] == 0 ? 1 : 0;
+    res[i] -= 1;
+  }
+  mtmath::limbs::trim(res);
+}
+
+static Limbs slice(const Limbs &a, size_t from, size_t to) {
+  to = std::min(to, a.size());
+  from = std::min(from, to);
+  Limbs res(a.begin() + static_cast<Limbs::difference_type>(from), a.begin() + static_cast<Limbs::difference_type>(to));
+  mtmath::limbs::trim(res);
+  return res;
+}
+
+static Limbs mul_basecase(const Limbs &a, const Limbs &b) {
+  Limbs res(a.size() + b.size(), 0);
+  for (size_t i = 0; i < a.size(); ++i) {
+    Limb carry = 0;
+    for (size_t j = 0; j < b.size(); ++j) {
+      auto t = static_cast<DoubleLimb>(a[i]) * b[j] + res[i + j] + carry;
+      res[i + j] = static_cast<Limb>(t);
+      carry = static_cast<Limb>(t >> LIMB_BITS);
+    }
+    res[i + b.size()] = carry;
+  }
+  mtmath::limbs::trim(res);
+  return res;
+}
+
+mtmath::limbs::Limbs mtmath::limbs::mul(const Limbs &a, const Limbs &b) {
+  if (a.empty() || b.empty()) {
+    return {};
+  }
+
+  const auto &bigger = a.size() >= b.size() ? a : b;
+  const auto &smaller = a.size() >= b.size() ? b : a;
+  if (smaller.size() < KARATSUBA_THRESHOLD) {
+    return mul_basecase(bigger, smaller);
+  }
+
+  Limbs res(bigger.size() + smaller.size() + 1, 0);
+
+  // Lopsided operands are split into chunks the size of the smaller one so Karatsuba stays balanced
+  if (bigger.size() >= 2 * smaller.size()) {
+    for (size_t offset = 0; offset < bigger.size(); offset += smaller.size()) {
+      add_into(res, offset, mul(slice(bigger, offset, offset + smaller.size()), smaller));
+    }
+    trim(res);
+    return res;
+  }
+
+  auto half = bigger.size() / 2;
+  auto a0 = slice(bigger, 0, half);
+  auto a1 = slice(bigger, half, bigger.size());
+  auto b0 = slice(smaller, 0, half);
+  auto b1 = slice(smaller, half, smaller.size());
+
+  auto z0 = mul(a0, b0);
+  auto z2 = mul(a1, b1);
+  auto z1 = mul(add(a0, a1), add(b0, b1));
+  sub_into(z1, z0);
+  sub_into(z1, z2);
+
+  add_into(res, 0, z0);
+  add_into(res, half, z1);
+  add_into(res, 2 * half, z2);
+  trim(res);
+  return res;
+}
+
+mtmath::limbs::Limbs mtmath::limbs::mul_1(const Limbs &a, Limb b) {
+  if (a.empty() || b == 0) {
+    return {};
+  }
+  Limbs res(a.size() + 1, 0);
+  Limb carry = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    auto t = static_cast<DoubleLimb>(a[i]) * b + carry;
+    res[i] = static_cast<Limb>(t);
+    carry = static_cast<Limb>(t >> LIMB_BITS);
+  }
+  res[a.size()] = carry;
+  trim(res);
+  return res;
+}
+
+mtmath::limbs::Limbs mtmath::limbs::shift_left(const Limbs &a, size_t bits) {
+  if (a.empty()) {
+    return {};
+  }
+  auto limbShift = bits / LIMB_BITS;
+  auto bitShift = bits % LIMB_BITS;
+  Limbs res(a.size() + limbShift + 1, 0);
+  for (size_t i = 0; i < a.size(); ++i) {
+    res[i + limbShift] |= a[i] << bitShift;
+    if (bitShift) {
+      res[i + limbShift + 1] = a[i] >> (LIMB_BITS - bitShift);
+    }
+  }
+  trim(res);
+  return res;
+}
+
+mtmath::limbs::Limbs mtmath::limbs::shift_right(const Limbs &a, size_t bits) {
+  auto limbShift = bits / LIMB_BITS;
+  auto bitShift = bits % LIMB_BITS;
+  if (limbShift >= a.size()) {
+    return {};
+  }
+  Limbs res(a.size() - limbShift, 0);
+  for (size_t i = 0; i < res.size(); ++i) {
+    res[i] = a[i + limbShift] >> bitShift;
+    if (bitShift && i + limbShift + 1 < a.size()) {
+      res[i] |= a[i + limbShift + 1] << (LIMB_BITS - bitShift);
+    }
+  }
+  trim(res);
+  return res;
+}
+
+std::tuple<Limbs, Limbs> mtmath::limbs::divide(const Limbs &n, const Limbs &d) {
+  if (compare(n, d) < 0) {
+    return std::make_tuple(n, Limbs{});
+  }
+
+  if (d.size() == 1) {
+    Limbs quotient(n.size(), 0);
+    auto rem = divrem_1(
+        n.size(), d[0],
+        [&n](size_t i) { return n[i]; },
+        [&quotient](size_t i, Limb q) { quotient[i] = q; });
+    trim(quotient);
+    Limbs remainder{rem};
+    trim(remainder);
+    return std::make_tuple(remainder, quotient);
+  }
+
+  // Knuth's Algorithm D, normalizing so the divisor's top limb has its high bit set
+  auto shift = static_cast<size_t>(std::countl_zero(d.back()));
+  auto vn = shift_left(d, shift);
+  auto un = shift_left(n, shift);
+  un.resize(n.size() + 1, 0);
+
+  auto dn = d.size();
+  auto m = n.size() - dn;
+  Limbs quotient(m + 1, 0);
+  auto vTop = vn[dn - 1];
+  auto vNext = vn[dn - 2];
+
+  for (size_t j = m + 1; j > 0; --j) {
+    auto pos = j - 1;
+    auto num = (static_cast<DoubleLimb>(un[pos + dn]) << LIMB_BITS) | un[pos + dn - 1];
+    auto qhat = num / vTop;
+    auto rhat = num % vTop;
+    while ((qhat >> LIMB_BITS) || qhat * vNext > ((rhat << LIMB_BITS) | un[pos + dn - 2])) {
+      --qhat;
+      rhat += vTop;
+      if (rhat >> LIMB_BITS) {
+        break;
+      }
+    }
+
+    auto q = static_cast<Limb>(qhat);
+    Limb carry = 0;
+    Limb borrow = 0;
+    for (size_t i = 0; i < dn; ++i) {
+      auto p = static_cast<DoubleLimb>(q) * vn[i] + carry;
+      carry = static_cast<Limb>(p >> LIMB_BITS);
+      auto diff = static_cast<DoubleLimb>(un[pos + i]) - static_cast<Limb>(p) - borrow;
+      un[pos + i] = static_cast<Limb>(diff);
+      borrow = static_cast<Limb>(diff >> LIMB_BITS) ? 1 : 0;
+    }
+    auto top = static_cast<DoubleLimb>(un[pos + dn]) - carry - borrow;
+    un[pos + dn] = static_cast<Limb>(top);
+
+    // Estimate was one too large, add the divisor back
+    if (top >> LIMB_BITS) {
+      --q;
+      Limb c = 0;
+      for (size_t i = 0; i < dn; ++i) {
+        auto sum = static_cast<DoubleLimb>(un[pos + i]) + vn[i] + c;
+        un[pos + i] = static_cast<Limb>(sum);
+        c = static_cast<Limb>(sum >> LIMB_BITS);
+      }
+      un[pos + dn] += c;
+    }
+    quotient[pos] = q;
+  }
+
+  un.resize(dn);
+  trim(un);
+  trim(quotient);
+  return std::make_tuple(shift_right(un, shift), quotient);
+}
+
+/**
+ * Jebelean's exact division. Once the divisor is made odd each quotient limb is the low limb of the running
+ * remainder times d^-1 mod 2^64, so no quotient estimation or remainder is needed. Only the low limbs that
+ * still produce quotient limbs are updated.
+ */
+mtmath::limbs::Limbs mtmath::limbs::divexact(const Limbs &n, const Limbs &d) {
+  if (n.empty()) {
+    return {};
+  }
+
+  size_t zeros = 0;
+  while (d[zeros / LIMB_BITS] == 0) {
+    zeros += LIMB_BITS;
+  }
+  zeros += static_cast<size_t>(std::countr_zero(d[zeros / LIMB_BITS]));
+  auto rem = shift_right(n, zeros);
+  auto den = shift_right(d, zeros);
+  if (den.size() == 1 && den[0] == 1) {
+    return rem;
+  }
+  if (rem.size() < den.size()) {
+    return {};
+  }
+
+  // Newton iteration for d^-1 mod 2^64, each step doubles the correct bits (d * d = 1 mod 8 to start)
+  Limb inv = den[0];
+  for (int i = 0; i < 5; ++i) {
+    inv *= 2 - den[0] * inv;
+  }
+
+  auto qn = rem.size() - den.size() + 1;
+  Limbs quotient(qn, 0);
+  for (size_t i = 0; i < qn; ++i) {
+    auto q = rem[i] * inv;
+    quotient[i] = q;
+    auto len = std::min(den.size(), qn - i);
+    Limb carry = 0;
+    for (size_t j = 0; j < len; ++j) {
+      auto p = static_cast<DoubleLimb>(q) * den[j] + carry;
+      auto low = static_cast<Limb>(p);
+      carry = static_cast<Limb>(p >> LIMB_BITS);
+      carry += rem[i + j] < low ? 1 : 0;
+      rem[i + j] -= low;
+    }
+    for (auto j = i + len; carry && j < qn; ++j) {
+      auto low = carry;
+      carry = rem[j] < low ? 1 : 0;
+      rem[j] -= low;
+    }
+  }
+  trim(quotient);
+  return quotient;
+}
+
+namespace {
+  /**
+   * Product of Euclidean quotient matrices [[q, 1], [1, 0]]. Entries are never negative,
+   * the sign of the determinant is tracked separately.
+   */
+  struct Matrix {
+    Limbs m00{1};
+    Limbs m01{};
+    Limbs m10{};
+    Limbs m11{1};
+    bool negativeDet = false;
+
+    [[nodiscard]] bool is_identity() const noexcept { return m01.empty() && m10.empty(); }
+  };
+
+  struct Reduction {
+    Matrix matrix;
+    Limbs a;
+    Limbs b;
+  };
+
+  // Signed cofactor for the extended gcd; zero is never negative
+  struct Cofactor {
+    Limbs mag;
+    bool negative = false;
+  };
+}
+
+// M = M * [[q, 1], [1, 0]]
+static void mul_quotient(Matrix &m, const Limbs &q) {
+  auto top = mtmath::limbs::add(mtmath::limbs::mul(m.m00, q), m.m01);
+  m.m01 = std::move(m.m00);
+  m.m00 = std::move(top);
+  auto bottom = mtmath::limbs::add(mtmath::limbs::mul(m.m10, q), m.m11);
+  m.m11 = std::move(m.m10);
+  m.m10 = std::move(bottom);
+  m.negativeDet = !m.negativeDet;
+}
+
+static Matrix mul_matrix(const Matrix &l, const Matrix &r) {
+  using mtmath::limbs::add;
+  using mtmath::limbs::mul;
+  Matrix res;
+  res.m00 = add(mul(l.m00, r.m00), mul(l.m01, r.m10));
+  res.m01 = add(mul(l.m00, r.m01), mul(l.m01, r.m11));
+  res.m10 = add(mul(l.m10, r.m00), mul(l.m11, r.m10));
+  res.m11 = add(mul(l.m10, r.m01), mul(l.m11, r.m11));
+  res.negativeDet = l.negativeDet != r.negativeDet;
+  return res;
+}
+
+// Removes the last quotient matrix from the product
+static void back_up(Matrix &m) {
+  using mtmath::limbs::divide;
+  using mtmath::limbs::mul;
+  using mtmath::limbs::sub;
+  auto q = std::get<1>(divide(m.m00, m.m01));
+  if (!m.m11.empty()) {
+    auto q2 = std::get<1>(divide(m.m10, m.m11));
+    if (mtmath::limbs::compare(q2, q) < 0) {
+      q = std::move(q2);
+    }
+  }
+  auto m01 = sub(m.m00, mul(q, m.m01));
+  auto m11 = sub(m.m10, mul(q, m.m11));
+  m.m00 = std::move(m.m01);
+  m.m01 = std::move(m01);
+  m.m10 = std::move(m.m11);
+  m.m11 = std::move(m11);
+  m.negativeDet = !m.negativeDet;
+}
+
+// Sets out to |x - y| and returns whether x - y is negative
+static bool signed_diff(const Limbs &x, const Limbs &y, Limbs &out) {
+  if (mtmath::limbs::compare(x, y) < 0) {
+    out = mtmath::limbs::sub(y, x);
+    return true;
+  }
+  out = mtmath::limbs::sub(x, y);
+  return false;
+}
+
+/**
+ * Computes (x, y) = M^-1 (a, b). A matrix found from truncated operands may overshoot for the full
+ * operands, so quotients are dropped from the end until (x, y) is a valid step of the remainder sequence.
+ */
+static void apply_inverse(Matrix &m, const Limbs &a, const Limbs &b, Limbs &x, Limbs &y) {
+  using mtmath::limbs::mul;
+  while (!m.is_identity()) {
+    auto xNeg = signed_diff(mul(m.m11, a), mul(m.m01, b), x) != m.negativeDet;
+    auto yNeg = signed_diff(mul(m.m00, b), mul(m.m10, a), y) != m.negativeDet;
+    if ((!xNeg || x.empty()) && (!yNeg || y.empty()) && mtmath::limbs::compare(x, y) > 0) {
+      return;
+    }
+    back_up(m);
+  }
+  x = a;
+  y = b;
+}
+
+static void euclid_step(Matrix *m, Limbs &a, Limbs &b) {
+  auto [r, q] = mtmath::limbs::divide(a, b);
+  if (m) {
+    mul_quotient(*m, q);
+  }
+  a = std::move(b);
+  b = std::move(r);
+}
+
+// Bits [shift, shift + 64) of a
+static Limb extract_bits(const Limbs &a, size_t shift) {
+  auto limbIndex = shift / LIMB_BITS;
+  auto bitIndex = shift % LIMB_BITS;
+  Limb res = limbIndex < a.size() ? a[limbIndex] >> bitIndex : 0;
+  if (bitIndex && limbIndex + 1 < a.size()) {
+    res |= a[limbIndex + 1] << (LIMB_BITS - bitIndex);
+  }
+  return res;
+}
+
+// x * a + y * b where x and y have opposite signs and the result is known to be non-negative
+static Limbs lin_comb(const Limbs &a, int64_t x, const Limbs &b, int64_t y) {
+  using mtmath::limbs::mul_1;
+  using mtmath::limbs::sub;
+  if (x >= 0 && y <= 0) {
+    return sub(mul_1(a, static_cast<Limb>(x)), mul_1(b, static_cast<Limb>(-y)));
+  }
+  return sub(mul_1(b, static_cast<Limb>(y)), mul_1(a, static_cast<Limb>(-x)));
+}
+
+static Limbs limb_of(int64_t v) {
+  Limbs res{static_cast<Limb>(v < 0 ? -v : v)};
+  mtmath::limbs::trim(res);
+  return res;
+}
+
+/**
+ * One step of Lehmer's gcd (Knuth's Algorithm L). Runs Euclid on the leading 61 bits and applies the
+ * accumulated cofactors to the full numbers. Returns false if no quotient could be determined.
+ * When m is given the quotients of the step are multiplied into it.
+ */
+static bool lehmer_step(Limbs &a, Limbs &b, Matrix *m) {
+  constexpr size_t LEADING_BITS = 61;
+  auto n = mtmath::limbs::bit_length(a);
+  auto shift = n > LEADING_BITS ? n - LEADING_BITS : 0;
+  auto uh = static_cast<int64_t>(extract_bits(a, shift));
+  auto vh = static_cast<int64_t>(extract_bits(b, shift));
+
+  int64_t A = 1, B = 0, C = 0, D = 1;
+  while (vh + C > 0 && vh + D > 0) {
+    auto q = (uh + A) / (vh + C);
+    if (q != (uh + B) / (vh + D)) {
+      break;
+    }
+    auto t = A - q * C;
+    A = C;
+    C = t;
+    t = B - q * D;
+    B = D;
+    D = t;
+    t = uh - q * vh;
+    uh = vh;
+    vh = t;
+  }
+
+  if (B == 0) {
+    return false;
+  }
+
+  if (m) {
+    // [a'; b'] = [[A, B], [C, D]] [a; b] is the inverse of the quotient product [[|D|, |B|], [|C|, |A|]]
+    Matrix step;
+    step.m00 = limb_of(D);
+    step.m01 = limb_of(B);
+    step.m10 = limb_of(C);
+    step.m11 = limb_of(A);
+    step.negativeDet = D < 0;
+    *m = mul_matrix(*m, step);
+  }
+
+  auto newA = lin_comb(a, A, b, B);
+  auto newB = lin_comb(a, C, b, D);
+  a = std::move(newA);
+  b = std::move(newB);
+  return true;
+}
+
+static void hgcd_finish(Reduction &red, size_t m) {
+  // Lehmer steps can remove up to a word of bits at once, so leave a margin to avoid overshooting m
+  while (mtmath::limbs::bit_length(red.b) > m) {
+    if (mtmath::limbs::bit_length(red.b) <= m + 2 * LIMB_BITS || !lehmer_step(red.a, red.b, &red.matrix)) {
+      euclid_step(&red.matrix, red.a, red.b);
+    }
+  }
+}
+
+/**
+ * Half gcd: for a >= b returns M and (a', b') = M^-1 (a, b) where a', b' are consecutive remainders
+ * with b' just below 2^ceil(bits(a) / 2). Each half of the reduction recurses on the top bits of
+ * the operands, so the work is dominated by the multiplications applying the matrices.
+ */
+static Reduction hgcd(const Limbs &a, const Limbs &b) {
+  using mtmath::limbs::bit_length;
+  using mtmath::limbs::shift_right;
+
+  auto m = (bit_length(a) + 1) / 2;
+  Reduction res{Matrix{}, a, b};
+  if (bit_length(b) <= m) {
+    return res;
+  }
+  if (a.size() < mtmath::limbs::HGCD_THRESHOLD) {
+    hgcd_finish(res, m);
+    return res;
+  }
+
+  auto first = hgcd(shift_right(a, m), shift_right(b, m));
+  res.matrix = std::move(first.matrix);
+  apply_inverse(res.matrix, a, b, res.a, res.b);
+
+  if (bit_length(res.b) > m) {
+    euclid_step(&res.matrix, res.a, res.b);
+    if (bit_length(res.b) > m) {
+      auto k = 2 * m - bit_length(res.a);
+      auto second = hgcd(shift_right(res.a, k), shift_right(res.b, k));
+      Limbs x;
+      Limbs y;
+      apply_inverse(second.matrix, res.a, res.b, x, y);
+      res.matrix = mul_matrix(res.matrix, second.matrix);
+      res.a = std::move(x);
+      res.b = std::move(y);
+    }
+  }
+
+  hgcd_finish(res, m);
+  return res;
+}
+
+mtmath::limbs::Limbs mtmath::limbs::gcd(Limbs a, Limbs b) {
+  trim(a);
+  trim(b);
+  if (compare(a, b) < 0) {
+    std::swap(a, b);
+  }
+
+  while (!b.empty()) {
+    if (b.size() >= HGCD_THRESHOLD) {
+      auto red = hgcd(a, b);
+      if (!red.matrix.is_identity()) {
+        a = std::move(red.a);
+        b = std::move(red.b);
+      }
+      if (!b.empty()) {
+        euclid_step(nullptr, a, b);
+      }
+    }
+    else if (a.size() == 1) {
+      return Limbs{std::gcd(a[0], b[0])};
+    }
+    else if (a.size() > b.size() + 1 || !lehmer_step(a, b, nullptr)) {
+      euclid_step(nullptr, a, b);
+    }
+  }
+  return a;
+}
+
+static Cofactor cofactor_mul(const Limbs &x, const Cofactor &c) {
+  auto mag = mtmath::limbs::mul(x, c.mag);
+  auto negative = c.negative && !mag.empty();
+  return Cofactor{std::move(mag), negative};
+}
+
+// x - y
+static Cofactor cofactor_sub(const Cofactor &x, const Cofactor &y) {
+  if (x.negative != y.negative) {
+    return Cofactor{mtmath::limbs::add(x.mag, y.mag), x.negative};
+  }
+  Cofactor res;
+  auto less = signed_diff(x.mag, y.mag, res.mag);
+  res.negative = !res.mag.empty() && less != x.negative;
+  return res;
+}
+
+// (s0, s1) = M^-1 (s0, s1), where M^-1 = det(M) [[m11, -m01], [-m10, m00]]
+static void apply_cofactors(const Matrix &m, Cofactor &s0, Cofactor &s1) {
+  auto n0 = cofactor_sub(cofactor_mul(m.m11, s0), cofactor_mul(m.m01, s1));
+  auto n1 = cofactor_sub(cofactor_mul(m.m00, s1), cofactor_mul(m.m10, s0));
+  if (m.negativeDet) {
+    n0.negative = !n0.negative && !n0.mag.empty();
+    n1.negative = !n1.negative && !n1.mag.empty();
+  }
+  s0 = std::move(n0);
+  s1 = std::move(n1);
+}
+
+std::tuple<Limbs, Limbs, bool> mtmath::limbs::gcdext(Limbs a, Limbs b) {
+  trim(a);
+  trim(b);
+
+  // Invariant: a = s0 * a_original (mod b_original), likewise for b with s1
+  Cofactor s0{Limbs{1}};
+  Cofactor s1{};
+  if (compare(a, b) < 0) {
+    std::swap(a, b);
+    std::swap(s0, s1);
+  }
+
+  while (!b.empty()) {
+    Matrix m;
+    if (b.size() >= HGCD_THRESHOLD) {
+      auto red = hgcd(a, b);
+      if (!red.matrix.is_identity()) {
+        apply_cofactors(red.matrix, s0, s1);
+        a = std::move(red.a);
+        b = std::move(red.b);
+      }
+    }
+    else if (a.size() > 1 && a.size() <= b.size() + 1 && lehmer_step(a, b, &m)) {
+      apply_cofactors(m, s0, s1);
+      continue;
+    }
+
+    if (!b.empty()) {
+      auto [r, q] = divide(a, b);
+      auto next = cofactor_sub(s0, cofactor_mul(q, s1));
+      a = std::move(b);
+      b = std::move(r);
+      s0 = std::move(s1);
+      s1 = std::move(next);
+    }
+  }
+  return std::make_tuple(std::move(a), std::move(s0.mag), s0.negative);
+}
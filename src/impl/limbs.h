@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace mtmath {
+  class ByteArray;
+
+  /**
+   * Word sized kernels used by BigInt for its heavy arithmetic.
+   * Numbers are unsigned, stored as little-endian 64-bit limbs with no leading zero limbs (zero is empty).
+   */
+  namespace limbs {
+    using Limb = uint64_t;
+    using DoubleLimb = unsigned __int128;
+    using Limbs = std::vector<Limb>;
+
+    // Below this many limbs multiplication uses the schoolbook method
+    constexpr size_t KARATSUBA_THRESHOLD = 32;
+    // At or above this many limbs gcd switches from Lehmer to the recursive half-gcd
+    constexpr size_t HGCD_THRESHOLD = 128;
+
+    Limbs from_bytes(const ByteArray& bytes);
+    Limbs from_bytes(std::span<const uint8_t> bytes);
+    ByteArray to_bytes(const Limbs& l);
+
+    void trim(Limbs& l) noexcept;
+    size_t bit_length(const Limbs& l) noexcept;
+    int compare(const Limbs& a, const Limbs& b) noexcept;
+
+    Limbs add(const Limbs& a, const Limbs& b);
+    // Requires a >= b
+    Limbs sub(const Limbs& a, const Limbs& b);
+    Limbs mul(const Limbs& a, const Limbs& b);
+    Limbs mul_1(const Limbs& a, Limb b);
+    // Returns (remainder, quotient) to mirror BigInt::divide. Requires d to be non-zero
+    std::tuple<Limbs, Limbs> divide(const Limbs& n, const Limbs& d);
+    // n / d when d is known to divide n. Requires d to be non-zero; the result is meaningless otherwise
+    Limbs divexact(const Limbs& n, const Limbs& d);
+
+    Limbs shift_left(const Limbs& a, size_t bits);
+    Limbs shift_right(const Limbs& a, size_t bits);
+
+    /**
+     * Unchecked kernels over little-endian byte magnitudes, used by BigInt's in place add, subtract and compare.
+     * They run a word at a time over raw pointers, so callers must guarantee the sizes
+     */
+    // dst[0, n) += src[0, m) with m <= n. Returns the carry out of the top byte. src may be dst
+    Limb add_bytes(uint8_t* dst, size_t n, const uint8_t* src, size_t m) noexcept;
+    // dst[0, n) = a[0, n) - b[0, m) with m <= n and a >= b. dst may be a, or b when m == n
+    void sub_bytes(uint8_t* dst, const uint8_t* a, size_t n, const uint8_t* b, size_t m) noexcept;
+    // Compares a[0, n) with b[0, n) from the most significant byte down
+    int compare_bytes(const uint8_t* a, const uint8_t* b, size_t n) noexcept;
+    // dst[0, n + 8) = dst[0, n) * b with n a multiple of the limb size, the carry limb landing at dst + n
+    void mul_1_bytes(uint8_t* dst, size_t n, Limb b) noexcept;
+    // Divides dst[0, n) by d in place with n a multiple of the limb size and returns the remainder. Requires d != 0
+    Limb divrem_1_bytes(uint8_t* dst, size_t n, Limb d) noexcept;
+
+    /**
+     * Greatest common divisor. Picks an algorithm by size: word gcd for single limbs,
+     * Lehmer for medium numbers, and a recursive half-gcd once operands reach HGCD_THRESHOLD limbs.
+     */
+    Limbs gcd(Limbs a, Limbs b);
+
+    /**
+     * Greatest common divisor g along with the cofactor s of a in g = s * a + t * b.
+     * Returns (g, |s|, whether s is negative); t can be recovered with an exact division.
+     */
+    std::tuple<Limbs, Limbs, bool> gcdext(Limbs a, Limbs b);
+  }
+}
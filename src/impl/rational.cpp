@@ -1,5 +1,8 @@
 #include "rational.h"
 #include "big_int.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <compare>
 
 template class mtmath::RationalBase<mtmath::BigInt>;
@@ -35,6 +38,9 @@ bool mtmath::immut::Rational::is_neg_infinity() const noexcept { return denomina
 bool mtmath::immut::Rational::is_finite() const noexcept { return !denominator.is_zero(); }
 
 std::strong_ordering mtmath::immut::Rational::operator<=>(const mtmath::immut::Rational &o) const noexcept {
+  if (is_finite() && o.is_finite()) {
+    return compare_fractions(numerator, denominator, o.numerator, o.denominator);
+  }
   auto n1 = numerator;
   auto n2 = o.numerator;
   if (denominator != o.denominator) {
@@ -58,17 +64,22 @@ mtmath::immut::Rational mtmath::immut::Rational::operator-() const noexcept {
 
 mtmath::immut::Rational mtmath::immut::Rational::operator+(const mtmath::immut::Rational &other) const noexcept {
   if (is_finite() && other.is_finite()) {
-    auto res = *this;
-    if (denominator == other.denominator) {
-      res.numerator = numerator + other.numerator;
-    }
-    else {
-      auto n1 = numerator * other.denominator;
-      auto n2 = other.numerator * denominator;
+    // Henrici's addition: both sides are already reduced, so only factors shared by the denominators can cancel
+    auto res = Rational{};
+    auto d1 = denominator == other.denominator ? denominator : gcd(denominator, other.denominator);
+    if (d1 == mtmath::immut::BigInt::one()) {
+      res.numerator = numerator * other.denominator + other.numerator * denominator;
       res.denominator = denominator * other.denominator;
-      res.numerator = n1 + n2;
-      res.simplify();
+      return res;
     }
+    auto ownPart = denominator.divexact(d1);
+    auto t = numerator * other.denominator.divexact(d1) + other.numerator * ownPart;
+    if (t.is_zero()) {
+      return res;
+    }
+    auto d2 = gcd(t, d1);
+    res.numerator = t.divexact(d2);
+    res.denominator = ownPart * other.denominator.divexact(d2);
     return res;
   }
   else if (is_pos_infinity() || is_neg_infinity()) {
@@ -77,6 +88,9 @@ mtmath::immut::Rational mtmath::immut::Rational::operator+(const mtmath::immut::
     }
     return std::numeric_limits<Rational>::quiet_NaN();
   }
+  else if (is_finite() && other.is_infinite()) {
+    return other;
+  }
   else {
     return std::numeric_limits<Rational>::quiet_NaN();
   }
@@ -87,6 +101,18 @@ mtmath::immut::Rational mtmath::immut::Rational::operator-(const mtmath::immut::
 }
 
 mtmath::immut::Rational mtmath::immut::Rational::operator*(const mtmath::immut::Rational &other) const noexcept {
+  if (is_finite() && other.is_finite()) {
+    auto res = Rational{};
+    if (numerator.is_zero() || other.numerator.is_zero()) {
+      return res;
+    }
+    // Cross-cancel before multiplying so the products are already in lowest terms
+    auto d1 = gcd(numerator, other.denominator);
+    auto d2 = gcd(denominator, other.numerator);
+    res.numerator = numerator.divexact(d1) * other.numerator.divexact(d2);
+    res.denominator = denominator.divexact(d2) * other.denominator.divexact(d1);
+    return res;
+  }
   auto res = Rational{numerator * other.numerator, denominator * other.denominator};
   res.simplify();
   return res;
@@ -121,6 +147,93 @@ mtmath::immut::Rational mtmath::immut::Rational::operator/(const mtmath::immut::
   }
 }
 
+mtmath::immut::Rational mtmath::immut::Rational::operator+(const mtmath::immut::BigInt &k) const noexcept {
+  if (!is_finite()) {
+    return *this;
+  }
+  return Rational{numerator + denominator * k, denominator, Reduced{}};
+}
+
+mtmath::immut::Rational mtmath::immut::Rational::operator-(const mtmath::immut::BigInt &k) const noexcept {
+  if (!is_finite()) {
+    return *this;
+  }
+  return Rational{numerator - denominator * k, denominator, Reduced{}};
+}
+
+mtmath::immut::Rational mtmath::immut::Rational::operator*(const mtmath::immut::BigInt &k) const noexcept {
+  if (!is_finite()) {
+    return *this * Rational{k};
+  }
+  if (numerator.is_zero() || k.is_zero()) {
+    return Rational{};
+  }
+  auto g = gcd(denominator, k);
+  if (g == 1) {
+    return Rational{numerator * k, denominator, Reduced{}};
+  }
+  return Rational{numerator * k.divexact(g), denominator.divexact(g), Reduced{}};
+}
+
+mtmath::immut::Rational mtmath::immut::Rational::operator/(const mtmath::immut::BigInt &k) const noexcept {
+  if (!is_finite() || k.is_zero()) {
+    return *this / Rational{k};
+  }
+  auto g = gcd(numerator, k);
+  auto n = g == 1 ? numerator : numerator.divexact(g);
+  auto d = denominator * (g == 1 ? k : k.divexact(g));
+  if (d.is_negative()) {
+    return Rational{-n, -d, Reduced{}};
+  }
+  return Rational{n, d, Reduced{}};
+}
+
+mtmath::immut::Rational mtmath::immut::Rational::from_double(double value) {
+  if (std::isnan(value)) {
+    return Rational{0, 0, Reduced{}};
+  }
+  else if (std::isinf(value)) {
+    return Rational{value < 0 ? -1 : 1, 0, Reduced{}};
+  }
+  auto [negative, mantissa, exponent] = split_double(value);
+  auto numerator = mtmath::immut::BigInt{mantissa};
+  if (negative) {
+    numerator = -numerator;
+  }
+  if (exponent >= 0) {
+    return Rational{numerator << static_cast<size_t>(exponent), 1, Reduced{}};
+  }
+  return Rational{numerator, mtmath::immut::BigInt::one() << static_cast<size_t>(-exponent), Reduced{}};
+}
+
+double mtmath::immut::Rational::to_double() const noexcept {
+  if (!is_finite()) {
+    if (is_nan()) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    return is_pos_infinity() ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+  }
+  if (numerator.is_zero()) {
+    return 0.0;
+  }
+  // Divide only far enough for a 66 bit quotient, the remainder just acts as a sticky bit
+  auto n = numerator.abs();
+  auto d = denominator;
+  auto scale = 66 + static_cast<int64_t>(d.bit_length()) - static_cast<int64_t>(n.bit_length());
+  if (scale > 0) {
+    n = n << static_cast<size_t>(scale);
+  }
+  else {
+    d = d << static_cast<size_t>(-scale);
+  }
+  auto [r, q] = n.divide(d);
+  if (!r.is_zero() && q % 2 == 0) {
+    q = q + 1;
+  }
+  auto res = q.to_double(-scale);
+  return numerator.is_negative() ? -res : res;
+}
+
 mtmath::immut::BigInt mtmath::immut::Rational::remainder(const mtmath::immut::BigInt &n, const mtmath::immut::BigInt &d) {
   if (n < mtmath::immut::BigInt::zero()) {
     return (-n) % d;
@@ -129,17 +242,7 @@ mtmath::immut::BigInt mtmath::immut::Rational::remainder(const mtmath::immut::Bi
 }
 
 mtmath::immut::BigInt mtmath::immut::Rational::gcd(const mtmath::immut::BigInt &a, const mtmath::immut::BigInt &b) {
-  auto A = a;
-  auto B = b;
-  while (!B.is_zero()) {
-    auto R = remainder(A, B);
-    A = B;
-    B = R;
-  }
-  if (A.is_negative()) {
-    return -A;
-  }
-  return A;
+  return mtmath::immut::BigInt::gcd(a, b);
 }
 
 void mtmath::immut::Rational::simplify() {
@@ -171,28 +274,372 @@ void mtmath::immut::Rational::simplify() {
     }
   }
 
-  denominator = denominator.abs();
+  if (denominator.is_negative()) {
+    numerator = -numerator;
+    denominator = denominator.abs();
+  }
   auto n = numerator;
   auto d = denominator;
   if (d == 1) {
     return;
   }
   else if (!d.is_zero()) {
-    if (remainder(n, d) == 0) {
-      numerator = n / d;
+    // One division gives both the divisibility check and the first Euclidean step of the gcd
+    auto [r, q] = n.divide(d);
+    if (r.is_zero()) {
+      numerator = q;
+      denominator = mtmath::immut::BigInt::one();
     }
     else {
-      auto g = gcd(n, d);
-      if (d > 0) {
-        numerator = n / g;
-        denominator = d / g;
+      auto g = gcd(d, r);
+      numerator = n.divexact(g);
+      denominator = d.divexact(g);
+    }
+  }
+}
+
+// 10^18 is the largest power of ten whose chunk quotients always fit in as_i64
+static constexpr size_t CHUNK_DIGITS = 18;
+// Largest exponent parse_fraction expands, so untrusted text cannot ask for a power of ten millions of digits long
+static constexpr int64_t MAX_DECIMAL_EXPONENT = 100000;
+
+static constexpr std::array<uint64_t, CHUNK_DIGITS + 1> POW10 = [] {
+  auto res = std::array<uint64_t, CHUNK_DIGITS + 1>{};
+  res[0] = 1;
+  for (size_t i = 1; i < res.size(); ++i) {
+    res[i] = res[i - 1] * 10;
+  }
+  return res;
+}();
+
+mtmath::DecimalExpansion::DecimalExpansion(const mtmath::BigInt &numerator, const mtmath::BigInt &denominator)
+    : denominator(denominator.abs_val()) {
+  auto [r, q] = numerator.abs_val().divide(this->denominator);
+  integer = std::move(q);
+  rest = std::move(r);
+}
+
+void mtmath::DecimalExpansion::next(std::string &out, size_t count) {
+  while (count > 0) {
+    if (rest.is_zero()) {
+      out.append(count, '0');
+      return;
+    }
+    auto chunk = std::min(count, CHUNK_DIGITS);
+    rest *= POW10[chunk];
+    auto [r, q] = rest.divide(denominator);
+    rest = std::move(r);
+    auto value = static_cast<uint64_t>(q.as_i64());
+    std::array<char, CHUNK_DIGITS> buffer{};
+    for (size_t i = chunk; i > 0; --i) {
+      buffer[i - 1] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    }
+    out.append(buffer.data(), chunk);
+    count -= chunk;
+  }
+}
+
+bool mtmath::DecimalExpansion::rounds_away(DecimalRounding rounding, bool negative, bool odd) const {
+  if (rest.is_zero()) {
+    return false;
+  }
+  return rounds_away(rounding, negative, odd, (rest << 1) <=> denominator);
+}
+
+bool mtmath::DecimalExpansion::rounds_away(DecimalRounding rounding, bool negative, bool odd, std::strong_ordering half) noexcept {
+  switch (rounding) {
+    case DecimalRounding::UP:
+      return true;
+    case DecimalRounding::DOWN:
+      return false;
+    case DecimalRounding::CEILING:
+      return !negative;
+    case DecimalRounding::FLOOR:
+      return negative;
+    case DecimalRounding::HALF_UP:
+      return half >= 0;
+    case DecimalRounding::HALF_DOWN:
+      return half > 0;
+    case DecimalRounding::HALF_EVEN:
+      return half > 0 || (half == 0 && odd);
+  }
+  return false;
+}
+
+static std::string join_decimal(bool negative, const mtmath::BigInt &integer, const std::string &fraction) {
+  auto res = std::string{};
+  if (negative && (!integer.is_zero() || fraction.find_first_not_of("0()") != std::string::npos)) {
+    res.push_back('-');
+  }
+  res += integer.to_string(10).value();
+  if (!fraction.empty()) {
+    res.push_back('.');
+    res += fraction;
+  }
+  return res;
+}
+
+std::string mtmath::DecimalExpansion::to_string(const mtmath::BigInt &numerator, const mtmath::BigInt &denominator, size_t digits, DecimalRounding rounding) {
+  auto negative = numerator.is_negative() != denominator.is_negative();
+  auto expansion = DecimalExpansion{numerator, denominator};
+  auto fraction = std::string{};
+  fraction.reserve(digits);
+  expansion.next(fraction, digits);
+  auto integer = expansion.integer_part();
+  auto odd = fraction.empty() ? integer % 2 != 0 : (fraction.back() - '0') % 2 != 0;
+  if (expansion.rounds_away(rounding, negative, odd)) {
+    // Carry through trailing nines into the integer part
+    auto carry = true;
+    for (auto it = fraction.rbegin(); carry && it != fraction.rend(); ++it) {
+      if (*it == '9') {
+        *it = '0';
+      }
+      else {
+        ++*it;
+        carry = false;
       }
-      else if (d < 0) {
-        numerator = -n / g;
-        denominator = -d / g;
+    }
+    if (carry) {
+      integer += 1;
+    }
+  }
+  return join_decimal(negative, integer, fraction);
+}
+
+std::optional<std::string> mtmath::DecimalExpansion::to_repeating_string(const mtmath::BigInt &numerator, const mtmath::BigInt &denominator, size_t maxPeriod) {
+  auto negative = numerator.is_negative() != denominator.is_negative();
+  // Digits before the cycle: the larger power of 2 or 5 in the denominator
+  auto twos = denominator.trailing_zeros();
+  auto odd = denominator.abs_val() >> twos;
+  size_t fives = 0;
+  while (odd % 5 == 0) {
+    odd /= 5;
+    ++fives;
+  }
+
+  auto expansion = DecimalExpansion{numerator, denominator};
+  auto fraction = std::string{};
+  expansion.next(fraction, std::max(twos, fives));
+  if (!expansion.exhausted()) {
+    auto start = expansion.remainder();
+    auto period = std::string{};
+    do {
+      if (period.size() == maxPeriod) {
+        return std::nullopt;
+      }
+      expansion.next(period, 1);
+    } while (expansion.remainder() != start);
+    fraction += '(' + period + ')';
+  }
+  return join_decimal(negative, expansion.integer_part(), fraction);
+}
+
+// 5^27 is the largest power of five in a word
+static constexpr size_t WORD_POW5 = 27;
+
+static constexpr std::array<uint64_t, WORD_POW5 + 1> POW5 = [] {
+  auto res = std::array<uint64_t, WORD_POW5 + 1>{};
+  res[0] = 1;
+  for (size_t i = 1; i < res.size(); ++i) {
+    res[i] = res[i - 1] * 5;
+  }
+  return res;
+}();
+
+static void multiply_pow5(mtmath::BigInt &value, size_t count) {
+  for (; count >= WORD_POW5; count -= WORD_POW5) {
+    value *= POW5[WORD_POW5];
+  }
+  if (count) {
+    value *= POW5[count];
+  }
+}
+
+// Appends decimal digits to value with one word multiply-add per chunk
+static void append_digits(mtmath::BigInt &value, std::string_view digits) {
+  for (size_t i = 0; i < digits.size(); i += CHUNK_DIGITS) {
+    auto chunk = digits.substr(i, CHUNK_DIGITS);
+    uint64_t word = 0;
+    for (auto ch : chunk) {
+      word = word * 10 + static_cast<uint64_t>(ch - '0');
+    }
+    value *= POW10[chunk.size()];
+    value += word;
+  }
+}
+
+static size_t digits_end(std::string_view text, size_t pos) {
+  while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+    ++pos;
+  }
+  return pos;
+}
+
+static bool equals_ignore_case(std::string_view text, std::string_view lower) {
+  return std::equal(text.begin(), text.end(), lower.begin(), lower.end(), [](char a, char b) {
+    return std::tolower(static_cast<unsigned char>(a)) == b;
+  });
+}
+
+std::optional<std::tuple<mtmath::BigInt, mtmath::BigInt>> mtmath::parse_fraction(std::string_view text) {
+  size_t pos = 0;
+  auto negative = false;
+  if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+    negative = text[pos] == '-';
+    ++pos;
+  }
+
+  auto word = text.substr(pos);
+  if (equals_ignore_case(word, "nan")) {
+    return std::make_tuple(mtmath::BigInt{0}, mtmath::BigInt{0});
+  }
+  else if (equals_ignore_case(word, "inf") || equals_ignore_case(word, "infinity")) {
+    return std::make_tuple(mtmath::BigInt{negative ? -1 : 1}, mtmath::BigInt{0});
+  }
+
+  auto numerator = mtmath::BigInt{};
+  auto end = digits_end(text, pos);
+  auto integerDigits = text.substr(pos, end - pos);
+  append_digits(numerator, integerDigits);
+  pos = end;
+
+  if (pos < text.size() && text[pos] == '/') {
+    end = digits_end(text, pos + 1);
+    if (integerDigits.empty() || end == pos + 1 || end != text.size()) {
+      return std::nullopt;
+    }
+    auto denominator = mtmath::BigInt{};
+    append_digits(denominator, text.substr(pos + 1, end - pos - 1));
+    if (negative) {
+      numerator = -numerator;
+    }
+    auto res = mtmath::Rational{std::move(numerator), std::move(denominator)};
+    return std::make_tuple(res.numerator(), res.denominator());
+  }
+
+  size_t fractionDigits = 0;
+  if (pos < text.size() && text[pos] == '.') {
+    end = digits_end(text, pos + 1);
+    fractionDigits = end - pos - 1;
+    append_digits(numerator, text.substr(pos + 1, fractionDigits));
+    pos = end;
+  }
+  if (integerDigits.empty() && fractionDigits == 0) {
+    return std::nullopt;
+  }
+
+  int64_t exponent = 0;
+  if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+    ++pos;
+    auto negativeExponent = false;
+    if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+      negativeExponent = text[pos] == '-';
+      ++pos;
+    }
+    end = digits_end(text, pos);
+    // Anything past 18 digits would overflow, and would be far too large to expand anyway
+    if (end == pos || end - pos > CHUNK_DIGITS) {
+      return std::nullopt;
+    }
+    for (; pos < end; ++pos) {
+      exponent = exponent * 10 + (text[pos] - '0');
+    }
+    // A short exponent must not expand into an enormous power of ten
+    if (exponent > MAX_DECIMAL_EXPONENT) {
+      return std::nullopt;
+    }
+    if (negativeExponent) {
+      exponent = -exponent;
+    }
+  }
+  if (pos != text.size()) {
+    return std::nullopt;
+  }
+
+  if (numerator.is_zero()) {
+    return std::make_tuple(mtmath::BigInt{0}, mtmath::BigInt{1});
+  }
+  auto denominator = mtmath::BigInt{1};
+  auto scale = exponent - static_cast<int64_t>(fractionDigits);
+  if (scale >= 0) {
+    multiply_pow5(numerator, static_cast<size_t>(scale));
+    numerator <<= static_cast<size_t>(scale);
+  }
+  else {
+    // The denominator is 2^k * 5^k, so the gcd can only be made of the 2s and 5s the numerator shares
+    auto k = static_cast<size_t>(-scale);
+    auto twos = std::min(numerator.trailing_zeros(), k);
+    numerator >>= twos;
+    // Strip whole words of fives, then read the few left in the last chunk off a single word remainder
+    size_t fives = 0;
+    while (k - fives >= WORD_POW5 && (numerator % POW5[WORD_POW5]).is_zero()) {
+      numerator /= POW5[WORD_POW5];
+      fives += WORD_POW5;
+    }
+    auto chunk = std::min(k - fives, WORD_POW5);
+    auto rem = static_cast<uint64_t>((numerator % POW5[chunk]).as_i64());
+    size_t last = 0;
+    if (rem == 0) {
+      last = chunk;
+    }
+    else {
+      for (; rem % 5 == 0; rem /= 5) {
+        ++last;
       }
     }
+    if (last) {
+      numerator /= POW5[last];
+      fives += last;
+    }
+    multiply_pow5(denominator, k - fives);
+    denominator <<= k - twos;
+  }
+  if (negative) {
+    numerator = -numerator;
+  }
+  return std::make_tuple(std::move(numerator), std::move(denominator));
+}
+
+std::optional<mtmath::RationalView> mtmath::RationalView::deserialize(std::span<const std::byte> in, size_t *consumed) noexcept {
+  size_t numeratorSize = 0;
+  size_t denominatorSize = 0;
+  auto numerator = mtmath::BigIntView::deserialize(in, &numeratorSize);
+  if (!numerator) {
+    return std::nullopt;
+  }
+  auto denominator = mtmath::BigIntView::deserialize(in.subspan(numeratorSize), &denominatorSize);
+  if (!denominator || !numerator->is_valid() || !denominator->is_valid() || denominator->is_negative()) {
+    return std::nullopt;
+  }
+  if (consumed) {
+    *consumed = numeratorSize + denominatorSize;
+  }
+  return RationalView{*numerator, *denominator};
+}
+
+mtmath::immut::Rational::Rational(const mtmath::RationalView &view)
+    : numerator(view.numerator()), denominator(view.denominator())
+{ simplify(); }
+
+size_t mtmath::immut::Rational::serialized_size() const noexcept {
+  return numerator.serialized_size() + denominator.serialized_size();
+}
+
+size_t mtmath::immut::Rational::serialize(std::span<std::byte> out) const noexcept {
+  if (out.size() < serialized_size()) {
+    return 0;
+  }
+  auto written = numerator.serialize(out);
+  return written + denominator.serialize(out.subspan(written));
+}
+
+std::optional<mtmath::immut::Rational> mtmath::immut::Rational::deserialize(std::span<const std::byte> in, size_t *consumed) {
+  auto view = mtmath::RationalView::deserialize(in, consumed);
+  if (!view) {
+    return std::nullopt;
   }
+  return Rational{*view};
 }
 
 void mtmath::c::into(const mtmath::Rational &bi, MtMath_Rational *out) {
@@ -1,16 +1,187 @@
 #pragma once
 
 #include "big_int.h"
+#include <bit>
+#include <cmath>
+#include <concepts>
 #include <memory>
+#include <optional>
 #include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
 
 namespace mtmath {
+  class Dyadic;
+
+  /**
+   * Orders n1/d1 against n2/d2 for finite fractions with positive denominators. Signs, bit lengths and a
+   * double precision estimate settle almost every comparison, only near ties pay for the exact cross multiplication.
+   * @tparam I mtmath::BigInt or mtmath::immut::BigInt
+   */
+  template<typename I>
+  std::strong_ordering compare_fractions(const I& n1, const I& d1, const I& n2, const I& d2) {
+    auto sign1 = n1.is_zero() ? 0 : (n1.is_negative() ? -1 : 1);
+    auto sign2 = n2.is_zero() ? 0 : (n2.is_negative() ? -1 : 1);
+    if (sign1 != sign2 || sign1 == 0) {
+      return sign1 <=> sign2;
+    }
+    if (d1 == d2) {
+      return n1 <=> n2;
+    }
+
+    // The estimates compare magnitudes, so flip the result when both are negative
+    auto orderBy = [&](std::strong_ordering magnitude) { return sign1 < 0 ? 0 <=> magnitude : magnitude; };
+
+    // n / d lies in (2^(bits(n) - bits(d) - 1), 2^(bits(n) - bits(d) + 1))
+    auto scale1 = static_cast<int64_t>(n1.bit_length()) - static_cast<int64_t>(d1.bit_length());
+    auto scale2 = static_cast<int64_t>(n2.bit_length()) - static_cast<int64_t>(d2.bit_length());
+    if (scale1 > scale2 + 1) {
+      return orderBy(std::strong_ordering::greater);
+    }
+    else if (scale2 > scale1 + 1) {
+      return orderBy(std::strong_ordering::less);
+    }
+
+    // Each quotient of leading mantissas is within a few ulps, far inside the tolerance. Rounding may carry a
+    // mantissa into the next power of two, so the frexp exponents are used rather than the bit lengths
+    int64_t expN1 = 0, expD1 = 0, expN2 = 0, expD2 = 0;
+    auto estimate1 = std::abs(n1.frexp(expN1)) / std::abs(d1.frexp(expD1));
+    auto estimate2 = std::abs(n2.frexp(expN2)) / std::abs(d2.frexp(expD2));
+    estimate2 = std::ldexp(estimate2, static_cast<int>((expN2 - expD2) - (expN1 - expD1)));
+    constexpr double tolerance = 0x1p-40;
+    if (estimate1 > estimate2 * (1 + tolerance)) {
+      return orderBy(std::strong_ordering::greater);
+    }
+    else if (estimate1 < estimate2 * (1 - tolerance)) {
+      return orderBy(std::strong_ordering::less);
+    }
+    return n1 * d2 <=> n2 * d1;
+  }
+
+  /**
+   * Rounding for decimal results, the same modes as java.math.BigDecimal. UP and DOWN are away from and toward zero
+   */
+  enum class DecimalRounding : uint8_t {
+    UP,
+    DOWN,
+    CEILING,
+    FLOOR,
+    HALF_UP,
+    HALF_DOWN,
+    HALF_EVEN
+  };
+
+  /**
+   * Streams the decimal digits of |numerator| / |denominator| after its integer part. Each step scales the remainder
+   * by 10^18 and does one long division, so nothing much larger than the denominator is ever built
+   */
+  class DecimalExpansion {
+  public:
+    /** Denominator must be non-zero */
+    DecimalExpansion(const mtmath::BigInt& numerator, const mtmath::BigInt& denominator);
+
+    [[nodiscard]] const mtmath::BigInt& integer_part() const noexcept { return integer; }
+    /** Numerator of what is left after the digits produced so far, over the denominator */
+    [[nodiscard]] const mtmath::BigInt& remainder() const noexcept { return rest; }
+    /** Every remaining digit is zero */
+    [[nodiscard]] bool exhausted() const noexcept { return rest.is_zero(); }
+
+    /** Appends the next count digits to out */
+    void next(std::string& out, size_t count);
+
+    /**
+     * Whether truncating here should instead step the last digit away from zero
+     * @param negative Sign of the value being expanded
+     * @param odd Whether the last digit kept is odd
+     */
+    [[nodiscard]] bool rounds_away(DecimalRounding rounding, bool negative, bool odd) const;
+
+    /**
+     * Rounding decision for a truncated quotient with a non-zero remainder
+     * @param half Twice the remainder compared against the divisor
+     */
+    static bool rounds_away(DecimalRounding rounding, bool negative, bool odd, std::strong_ordering half) noexcept;
+
+    /** numerator / denominator rounded to the given number of fraction digits, e.g. "-0.667" */
+    static std::string to_string(const mtmath::BigInt& numerator, const mtmath::BigInt& denominator, size_t digits, DecimalRounding rounding);
+
+    /**
+     * Exact expansion of a fraction in lowest terms with the repeating part in parentheses, e.g. "0.1(6)".
+     * The digits before the cycle are counted from the twos and fives of the denominator, then the cycle is found
+     * when the remainder comes back around. Empty if the cycle is longer than maxPeriod digits
+     */
+    static std::optional<std::string> to_repeating_string(const mtmath::BigInt& numerator, const mtmath::BigInt& denominator, size_t maxPeriod);
+
+  private:
+    mtmath::BigInt integer;
+    mtmath::BigInt rest;
+    mtmath::BigInt denominator;
+  };
+
+  /**
+   * Numerator and denominator of decimal ("-12.5"), scientific ("123.4567e-12") or fraction ("3/8") text, in lowest
+   * terms with a non-negative denominator. NaN, inf and infinity give 0/0 and +-1/0. Empty unless all of the text
+   * is a number, or if the exponent is beyond +-100000
+   */
+  std::optional<std::tuple<mtmath::BigInt, mtmath::BigInt>> parse_fraction(std::string_view text);
+
+  /**
+   * Read-only rational over serialized bytes, which are the numerator's encoding followed by the denominator's.
+   * The parts are not checked to be in lowest terms, so rationals built from a view reduce them
+   */
+  class RationalView {
+    mtmath::BigIntView m_numerator = {};
+    mtmath::BigIntView m_denominator = {};
+
+  public:
+    RationalView() = default;
+    RationalView(mtmath::BigIntView numerator, mtmath::BigIntView denominator) noexcept
+        : m_numerator(numerator), m_denominator(denominator) {}
+
+    [[nodiscard]] const mtmath::BigIntView& numerator() const noexcept { return m_numerator; }
+    [[nodiscard]] const mtmath::BigIntView& denominator() const noexcept { return m_denominator; }
+
+    /** Views one serialized rational at the front of in. Empty if malformed or the denominator is negative */
+    static std::optional<RationalView> deserialize(std::span<const std::byte> in, size_t* consumed = nullptr) noexcept;
+  };
+
+  /**
+   * Integers which a rational with underlying type T can be offset or scaled by directly
+   */
+  template<typename I, typename T>
+  concept IntegerOperand = std::same_as<I, T> || (std::integral<I> && sizeof(I) <= sizeof(uint64_t));
+
+  /**
+   * Normalization policy which reduces to lowest terms after every operation
+   */
+  struct EagerNormalization {};
+
+  /**
+   * Normalization policy which defers reducing to lowest terms until the value is compared, printed or
+   * its parts are accessed. Values are also reduced once the numerator or denominator grows past MaxBits, or past
+   * twice its size at the last reduction for values which are large even in lowest terms, so long accumulation
+   * chains stay bounded.
+   *
+   * Not thread safe for const access: comparing, printing or reading the parts of a pending value reduces it in
+   * place, even through a const reference, so two threads reading the same value race. Call normalize() before
+   * sharing a value between threads; once reduced, const reads no longer write
+   */
+  template<size_t MaxBits = 4096>
+  struct LazyNormalization {
+    static constexpr size_t max_bits = MaxBits;
+  };
+
   /**
    * Base for rational numbers. Does not try to do structural sharing, works with full copies
    * @tparam T Underlying type for rational numbers
+   * @tparam Normalization When to reduce to lowest terms (EagerNormalization or LazyNormalization)
    */
-  template<typename T>
+  template<typename T, typename Normalization = EagerNormalization>
   class RationalBase {
+    static constexpr bool lazy = !std::is_same_v<Normalization, EagerNormalization>;
+
   public:
     static_assert(std::numeric_limits<T>::is_signed, "Rationals must use signed numbers");
 
@@ -25,32 +196,172 @@ namespace mtmath {
 
     RationalBase(RationalBase&& rb) noexcept
         : m_numerator(std::move(rb.m_numerator)),
-          m_denominator(std::move(rb.m_denominator))
+          m_denominator(std::move(rb.m_denominator)),
+          m_pending(rb.m_pending),
+          m_reduced_bits(rb.m_reduced_bits)
     {}
 
     RationalBase(const RationalBase& rb)
         : m_numerator(rb.m_numerator),
-          m_denominator(rb.m_denominator)
+          m_denominator(rb.m_denominator),
+          m_pending(rb.m_pending),
+          m_reduced_bits(rb.m_reduced_bits)
     {}
 
     RationalBase& operator=(const RationalBase& rb) {
       m_numerator = rb.m_numerator;
       m_denominator = rb.m_denominator;
+      m_pending = rb.m_pending;
+      m_reduced_bits = rb.m_reduced_bits;
       return *this;
     }
 
     RationalBase& operator=(RationalBase&& rb) noexcept {
       std::swap(m_numerator, rb.m_numerator);
       std::swap(m_denominator, rb.m_denominator);
+      std::swap(m_pending, rb.m_pending);
+      std::swap(m_reduced_bits, rb.m_reduced_bits);
       return *this;
     }
 
+    /**
+     * Exact value of a double. The mantissa and a power of two denominator are already coprime, so no gcd is needed
+     */
+    static RationalBase from_double(double value) requires std::is_same_v<T, mtmath::BigInt> {
+      if (std::isnan(value)) {
+        return RationalBase{T{0}, T{0}, Reduced{}};
+      }
+      else if (std::isinf(value)) {
+        return RationalBase{T{value < 0 ? -1 : 1}, T{0}, Reduced{}};
+      }
+      auto [negative, mantissa, exponent] = split_double(value);
+      auto numerator = T{mantissa};
+      if (negative) {
+        numerator = -numerator;
+      }
+      if (exponent >= 0) {
+        return RationalBase{numerator << static_cast<size_t>(exponent), T{1}, Reduced{}};
+      }
+      return RationalBase{std::move(numerator), T{1} << static_cast<size_t>(-exponent), Reduced{}};
+    }
+
+    /**
+     * Nearest double (ties to even). Divides only far enough for a 66 bit quotient, the remainder just acts as a sticky bit
+     */
+    [[nodiscard]] double to_double() const noexcept {
+      if (!is_finite()) {
+        if (is_nan()) {
+          return std::numeric_limits<double>::quiet_NaN();
+        }
+        return is_pos_infinity() ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+      }
+      if (m_numerator == 0) {
+        return 0.0;
+      }
+      auto n = mtmath::BigInt{m_numerator};
+      auto d = mtmath::BigInt{m_denominator};
+      auto negative = n.is_negative();
+      n.abs();
+      auto scale = 66 + static_cast<int64_t>(d.bit_length()) - static_cast<int64_t>(n.bit_length());
+      if (scale > 0) {
+        n <<= static_cast<size_t>(scale);
+      }
+      else {
+        d <<= static_cast<size_t>(-scale);
+      }
+      auto [r, q] = n.divide(d);
+      if (!r.is_zero() && q % 2 == 0) {
+        q += 1;
+      }
+      auto res = q.to_double(-scale);
+      return negative ? -res : res;
+    }
+
+    /** Copies a view's parts and reduces them, since stored data may not be in lowest terms */
+    explicit RationalBase(const RationalView& view) requires std::is_same_v<T, mtmath::BigInt>
+        : RationalBase(T{view.numerator()}, T{view.denominator()}) {}
+
+    [[nodiscard]] size_t serialized_size() const noexcept requires std::is_same_v<T, mtmath::BigInt> {
+      return numerator().serialized_size() + denominator().serialized_size();
+    }
+
+    /** Writes the numerator's encoding then the denominator's. Returns the bytes written, or 0 if out is too small */
+    size_t serialize(std::span<std::byte> out) const noexcept requires std::is_same_v<T, mtmath::BigInt> {
+      if (out.size() < serialized_size()) {
+        return 0;
+      }
+      auto written = numerator().serialize(out);
+      return written + denominator().serialize(out.subspan(written));
+    }
+
+    /** Reads one encoded rational from the front of in, see RationalView::deserialize */
+    static std::optional<RationalBase> deserialize(std::span<const std::byte> in, size_t* consumed = nullptr) requires std::is_same_v<T, mtmath::BigInt> {
+      auto view = RationalView::deserialize(in, consumed);
+      if (!view) {
+        return std::nullopt;
+      }
+      return RationalBase{*view};
+    }
+
+    /**
+     * Parses decimal, scientific or fraction text in a single pass. Digits are read 18 at a time into word sized
+     * multiply-adds, and since a decimal's denominator is a power of ten only factors of 2 and 5 are cancelled
+     * instead of running a gcd
+     */
+    static std::optional<RationalBase> parse(std::string_view text) requires std::is_same_v<T, mtmath::BigInt> {
+      auto parts = parse_fraction(text);
+      if (!parts) {
+        return std::nullopt;
+      }
+      auto& [numerator, denominator] = *parts;
+      return RationalBase{std::move(numerator), std::move(denominator), Reduced{}};
+    }
+
+    /**
+     * Fixed point decimal text with the given number of fraction digits, produced digit chunk by chunk from the
+     * remainder rather than by scaling the numerator up front. Non-finite values give NaN, inf or -inf
+     */
+    [[nodiscard]] std::string to_decimal_string(size_t digits, DecimalRounding rounding = DecimalRounding::HALF_EVEN) const requires std::is_same_v<T, mtmath::BigInt> {
+      if (!is_finite()) {
+        return special_string();
+      }
+      return DecimalExpansion::to_string(numerator(), denominator(), digits, rounding);
+    }
+
+    /**
+     * Exact decimal text with any repeating digits in parentheses, e.g. "-1.8(3)". Empty when the repeating
+     * part is longer than maxPeriod digits
+     */
+    [[nodiscard]] std::optional<std::string> to_repeating_decimal_string(size_t maxPeriod = 4096) const requires std::is_same_v<T, mtmath::BigInt> {
+      if (!is_finite()) {
+        return special_string();
+      }
+      return DecimalExpansion::to_repeating_string(numerator(), denominator(), maxPeriod);
+    }
+
+    /**
+     * Reduces to lowest terms if a lazy operation left the value unreduced. Lazy values must be normalized before
+     * being read from several threads, see LazyNormalization
+     */
+    void normalize() const {
+      if (m_pending) {
+        reduce();
+      }
+    }
+
     [[nodiscard]] bool is_nan() const noexcept { return m_denominator == T{0} && m_numerator == T{0}; }
     [[nodiscard]] bool is_infinite() const noexcept { return m_denominator == T{0} && m_numerator != T{0}; }
     [[nodiscard]] bool is_pos_infinity() const noexcept { return m_denominator == T{0} && m_numerator > T{0}; }
     [[nodiscard]] bool is_neg_infinity() const noexcept { return m_denominator == T{0} && m_numerator < T{0}; }
     [[nodiscard]] bool is_finite() const noexcept { return m_denominator != T{0}; }
     [[nodiscard]] std::strong_ordering operator<=>(const RationalBase& o) const noexcept {
+      normalize();
+      o.normalize();
+      if constexpr (std::is_same_v<T, mtmath::BigInt>) {
+        if (is_finite() && o.is_finite()) {
+          return compare_fractions(m_numerator, m_denominator, o.m_numerator, o.m_denominator);
+        }
+      }
       auto n1 = m_numerator;
       auto n2 = o.m_numerator;
       if (m_denominator != o.m_denominator) {
@@ -75,21 +386,43 @@ namespace mtmath {
     }
 
     RationalBase operator-() const noexcept {
-      return mtmath::RationalBase<T>{-m_numerator, m_denominator};
+      // Negating never changes the gcd, so neither a reduced nor a pending value needs a reduction here
+      auto res = RationalBase{-m_numerator, m_denominator, Reduced{}};
+      res.m_pending = m_pending;
+      res.m_reduced_bits = m_reduced_bits;
+      return res;
     }
 
     RationalBase& operator+=(const RationalBase& other) noexcept {
       if (is_finite() && other.is_finite()) {
-        if (m_denominator == other.m_denominator) {
-          m_numerator = m_numerator + other.m_numerator;
+        if constexpr (lazy) {
+          if (m_denominator == other.m_denominator) {
+            m_numerator = m_numerator + other.m_numerator;
+          }
+          else {
+            m_numerator = m_numerator * other.m_denominator + other.m_numerator * m_denominator;
+            m_denominator = m_denominator * other.m_denominator;
+          }
+          defer();
+          return *this;
         }
-        else {
-          auto n1 = m_numerator * other.m_denominator;
-          auto n2 = other.m_numerator * m_denominator;
+        // Henrici's addition: both sides are already reduced, so only factors shared by the denominators can cancel
+        auto d1 = m_denominator == other.m_denominator ? m_denominator : gcd(m_denominator, other.m_denominator);
+        if (d1 == 1) {
+          m_numerator = m_numerator * other.m_denominator + other.m_numerator * m_denominator;
           m_denominator = m_denominator * other.m_denominator;
-          m_numerator = n1 + n2;
-          simplify();
+          return *this;
+        }
+        auto ownPart = exact_div(m_denominator, d1);
+        auto t = m_numerator * exact_div(other.m_denominator, d1) + other.m_numerator * ownPart;
+        if (t == 0) {
+          m_numerator = 0;
+          m_denominator = 1;
+          return *this;
         }
+        auto d2 = gcd(t, d1);
+        m_numerator = exact_div(t, d2);
+        m_denominator = ownPart * exact_div(other.m_denominator, d2);
         return *this;
       }
       else if (is_pos_infinity() || is_neg_infinity()) {
@@ -100,6 +433,11 @@ namespace mtmath {
         m_denominator = 0;
         return *this;
       }
+      else if (is_finite() && other.is_infinite()) {
+        m_numerator = other.m_numerator;
+        m_denominator = 0;
+        return *this;
+      }
       else {
         m_numerator = 0;
         m_denominator = 0;
@@ -125,6 +463,25 @@ namespace mtmath {
     }
 
     RationalBase& operator*=(const RationalBase& other) noexcept {
+      if (is_finite() && other.is_finite()) {
+        if constexpr (lazy) {
+          m_numerator *= other.m_numerator;
+          m_denominator *= other.m_denominator;
+          defer();
+          return *this;
+        }
+        if (m_numerator == 0 || other.m_numerator == 0) {
+          m_numerator = 0;
+          m_denominator = 1;
+          return *this;
+        }
+        // Cross-cancel before multiplying so the products are already in lowest terms
+        auto d1 = gcd(m_numerator, other.m_denominator);
+        auto d2 = gcd(m_denominator, other.m_numerator);
+        m_numerator = exact_div(m_numerator, d1) * exact_div(other.m_numerator, d2);
+        m_denominator = exact_div(m_denominator, d2) * exact_div(other.m_denominator, d1);
+        return *this;
+      }
       m_numerator *= other.m_numerator;
       m_denominator *= other.m_denominator;
       simplify();
@@ -162,6 +519,17 @@ namespace mtmath {
       else {
         m_numerator *= other.m_denominator;
         m_denominator *= other.m_numerator;
+        if constexpr (lazy) {
+          if (other.m_numerator != 0) {
+            // Keep the sign on the numerator so unreduced values still compare and add correctly
+            if (m_denominator < 0) {
+              m_numerator = -m_numerator;
+              m_denominator = -m_denominator;
+            }
+            defer();
+            return *this;
+          }
+        }
       }
       simplify();
       return *this;
@@ -173,46 +541,219 @@ namespace mtmath {
       return copy;
     }
 
-    friend std::ostream& operator<<(std::ostream& o, const mtmath::RationalBase<T>& r)
+    /**
+     * Adds an integer. (n + k * d) / d shares no factor with d, so no gcd is needed
+     */
+    template<typename I> requires IntegerOperand<I, T>
+    RationalBase& operator+=(const I& k) noexcept {
+      if (is_finite()) {
+        m_numerator += m_denominator * operand(k);
+        if constexpr (lazy) {
+          if (m_pending) {
+            defer();
+          }
+        }
+      }
+      return *this;
+    }
+
+    template<typename I> requires IntegerOperand<I, T>
+    RationalBase& operator-=(const I& k) noexcept {
+      if (is_finite()) {
+        m_numerator -= m_denominator * operand(k);
+        if constexpr (lazy) {
+          if (m_pending) {
+            defer();
+          }
+        }
+      }
+      return *this;
+    }
+
+    /**
+     * Multiplies by an integer, cancelling the single gcd of k with the denominator
+     */
+    template<typename I> requires IntegerOperand<I, T>
+    RationalBase& operator*=(const I& k) noexcept {
+      if (!is_finite()) {
+        return *this *= RationalBase{T(k)};
+      }
+      if constexpr (lazy) {
+        m_numerator *= operand(k);
+        defer();
+        return *this;
+      }
+      if (m_numerator == 0 || k == 0) {
+        m_numerator = 0;
+        m_denominator = 1;
+        return *this;
+      }
+      auto g = gcd(m_denominator, T(k));
+      if (g == 1) {
+        m_numerator *= operand(k);
+      }
+      else {
+        m_numerator *= exact_div(T(k), g);
+        m_denominator = exact_div(m_denominator, g);
+      }
+      return *this;
+    }
+
+    /**
+     * Divides by an integer, cancelling the single gcd of k with the numerator
+     */
+    template<typename I> requires IntegerOperand<I, T>
+    RationalBase& operator/=(const I& k) noexcept {
+      if (!is_finite() || k == 0) {
+        return *this /= RationalBase{T(k)};
+      }
+      if constexpr (lazy) {
+        m_denominator *= operand(k);
+      }
+      else {
+        auto g = gcd(m_numerator, T(k));
+        if (g == 1) {
+          m_denominator *= operand(k);
+        }
+        else {
+          m_numerator = exact_div(m_numerator, g);
+          m_denominator *= exact_div(T(k), g);
+        }
+      }
+      if (m_denominator < 0) {
+        m_numerator = -m_numerator;
+        m_denominator = -m_denominator;
+      }
+      if constexpr (lazy) {
+        defer();
+      }
+      return *this;
+    }
+
+    template<typename I> requires IntegerOperand<I, T>
+    RationalBase operator+(const I& k) const noexcept { auto copy = *this; return copy += k; }
+    template<typename I> requires IntegerOperand<I, T>
+    RationalBase operator-(const I& k) const noexcept { auto copy = *this; return copy -= k; }
+    template<typename I> requires IntegerOperand<I, T>
+    RationalBase operator*(const I& k) const noexcept { auto copy = *this; return copy *= k; }
+    template<typename I> requires IntegerOperand<I, T>
+    RationalBase operator/(const I& k) const noexcept { auto copy = *this; return copy /= k; }
+
+    friend std::ostream& operator<<(std::ostream& o, const RationalBase& r)
     {
+      r.normalize();
       o << r.m_numerator << "/" << r.m_denominator;
       return o;
     }
 
     const T& numerator() const noexcept {
+        normalize();
         return m_numerator;
     }
 
     const T& denominator() const noexcept {
+      normalize();
       return m_denominator;
     }
 
   private:
-    T m_numerator;
-    T m_denominator;
+    friend class mtmath::Dyadic;
+
+    // Tags parts which are already in lowest terms with a non-negative denominator
+    struct Reduced {};
+    RationalBase(T numerator, T denominator, Reduced) noexcept : m_numerator(std::move(numerator)), m_denominator(std::move(denominator)) {}
+
+    // Mutable so a lazily normalized value can be reduced when it is observed through a const reference. This makes
+    // const reads of a pending value writes, so they are not safe to share between threads
+    mutable T m_numerator;
+    mutable T m_denominator;
+    mutable bool m_pending = false;
+    // Size of the larger part at the last lazy reduction
+    mutable size_t m_reduced_bits = 0;
+
+    static size_t bit_length(const T& v) {
+      if constexpr (std::is_same_v<T, mtmath::BigInt>) {
+        return v.bit_length();
+      }
+      else {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<size_t>(std::bit_width(v < 0 ? static_cast<U>(0) - static_cast<U>(v) : static_cast<U>(v)));
+      }
+    }
+
+    void defer() {
+      if constexpr (lazy) {
+        m_pending = true;
+        // Values which stay large in lowest terms would otherwise pay for a full gcd on every operation
+        auto bits = std::max(bit_length(m_numerator), bit_length(m_denominator));
+        if (bits > std::max(Normalization::max_bits, 2 * m_reduced_bits)) {
+          reduce();
+        }
+      }
+    }
+
+    void reduce() const {
+      simplify();
+      if constexpr (lazy) {
+        m_reduced_bits = std::max(bit_length(m_numerator), bit_length(m_denominator));
+      }
+    }
+
+    std::string special_string() const {
+      if (is_nan()) {
+        return "NaN";
+      }
+      return is_pos_infinity() ? "inf" : "-inf";
+    }
+
+    // BigInt has single word overloads for machine integers; other underlying types convert first
+    template<typename I>
+    static decltype(auto) operand(const I& k) {
+      if constexpr (std::is_same_v<T, mtmath::BigInt>) {
+        return (k);
+      }
+      else {
+        return static_cast<T>(k);
+      }
+    }
 
-    T remainder(const T& n, const T&d) {
+    static T remainder(const T& n, const T&d) {
       if (n < 0) {
         return (-n) % d;
       }
       return n % d;
     }
 
-    T gcd(const T& a, const T& b) {
-      auto A = a;
-      auto B = b;
-      while (B != 0) {
-        auto R = remainder(A, B);
-        A = B;
-        B = R;
+    static T gcd(const T& a, const T& b) {
+      if constexpr (std::is_same_v<T, mtmath::BigInt>) {
+        return mtmath::BigInt::gcd(a, b);
       }
-      if (A < 0) {
-        return -A;
+      else {
+        auto A = a;
+        auto B = b;
+        while (B != 0) {
+          auto R = remainder(A, B);
+          A = B;
+          B = R;
+        }
+        if (A < 0) {
+          return -A;
+        }
+        return A;
+      }
+    }
+
+    static T exact_div(const T& n, const T& d) {
+      if constexpr (std::is_same_v<T, mtmath::BigInt>) {
+        return n.divexact(d);
+      }
+      else {
+        return n / d;
       }
-      return A;
     }
 
-    void simplify() {
+    void simplify() const {
+      m_pending = false;
       if constexpr (std::numeric_limits<T>::has_quiet_NaN) {
         auto nan = std::numeric_limits<T>::quiet_NaN();
         if (m_numerator == nan || m_denominator == nan) {
@@ -242,6 +783,7 @@ namespace mtmath {
       }
 
       if (m_denominator < 0) {
+        m_numerator = -m_numerator;
         m_denominator = -m_denominator;
       }
       auto n = m_numerator;
@@ -250,19 +792,27 @@ namespace mtmath {
         return;
       }
       else if (d != 0) {
-        if (remainder(n, d) == 0) {
+        if constexpr (std::is_same_v<T, mtmath::BigInt>) {
+          // One division gives both the divisibility check and the first Euclidean step of the gcd
+          auto [r, q] = n.divide(d);
+          if (r.is_zero()) {
+            m_numerator = std::move(q);
+            m_denominator = 1;
+          }
+          else {
+            auto g = gcd(d, r);
+            m_numerator = exact_div(n, g);
+            m_denominator = exact_div(d, g);
+          }
+        }
+        else if (remainder(n, d) == 0) {
           m_numerator = n / d;
+          m_denominator = 1;
         }
         else {
           auto g = gcd(n, d);
-          if (d > 0) {
-            m_numerator = n / g;
-            m_denominator = d / g;
-          }
-          else if (d < 0) {
-            m_numerator = -n / g;
-            m_denominator = -d / g;
-          }
+          m_numerator = exact_div(n, g);
+          m_denominator = exact_div(d, g);
         }
       }
     }
@@ -270,6 +820,10 @@ namespace mtmath {
 
   extern template class RationalBase<mtmath::BigInt>;
   using Rational = RationalBase<mtmath::BigInt>;
+  /**
+   * Rational which only reduces when observed or when its parts grow too large. Meant for long accumulations
+   */
+  using LazyRational = RationalBase<mtmath::BigInt, LazyNormalization<>>;
 
   namespace c {
     void into(const mtmath::Rational& bi, MtMath_Rational* out);
@@ -309,6 +863,40 @@ namespace mtmath {
 
       Rational operator/(const Rational& other) const noexcept;
 
+      /** (n + k * d) / d is already in lowest terms */
+      Rational operator+(const mtmath::immut::BigInt& k) const noexcept;
+      Rational operator-(const mtmath::immut::BigInt& k) const noexcept;
+      /** Cancels the single gcd of k with the denominator */
+      Rational operator*(const mtmath::immut::BigInt& k) const noexcept;
+      /** Cancels the single gcd of k with the numerator */
+      Rational operator/(const mtmath::immut::BigInt& k) const noexcept;
+
+      template<WordInteger I>
+      Rational operator+(I k) const noexcept {
+        return is_finite() ? Rational{numerator + denominator * k, denominator, Reduced{}} : *this;
+      }
+      template<WordInteger I>
+      Rational operator-(I k) const noexcept {
+        return is_finite() ? Rational{numerator - denominator * k, denominator, Reduced{}} : *this;
+      }
+      template<WordInteger I>
+      Rational operator*(I k) const noexcept { return *this * mtmath::immut::BigInt{k}; }
+      template<WordInteger I>
+      Rational operator/(I k) const noexcept { return *this / mtmath::immut::BigInt{k}; }
+
+      /** Copies a view's parts, which are already in lowest terms */
+      explicit Rational(const mtmath::RationalView& view);
+
+      [[nodiscard]] size_t serialized_size() const noexcept;
+      /** Same encoding as mtmath::Rational::serialize */
+      size_t serialize(std::span<std::byte> out) const noexcept;
+      static std::optional<Rational> deserialize(std::span<const std::byte> in, size_t* consumed = nullptr);
+
+      /** Exact value of a double with no gcd work */
+      static Rational from_double(double value);
+      /** Nearest double (ties to even) */
+      [[nodiscard]] double to_double() const noexcept;
+
       friend std::ostream& operator<<(std::ostream& o, const Rational& r)  {
         o << r.numerator;
         o << "/";
@@ -320,6 +908,11 @@ namespace mtmath {
       mtmath::immut::BigInt numerator;
       mtmath::immut::BigInt denominator;
 
+      // Tags a numerator and denominator which are already in lowest terms with a positive denominator
+      struct Reduced {};
+      Rational(mtmath::immut::BigInt numerator, mtmath::immut::BigInt denominator, Reduced) noexcept
+          : numerator(std::move(numerator)), denominator(std::move(denominator)) {}
+
       static mtmath::immut::BigInt remainder(const mtmath::immut::BigInt& n, const mtmath::immut::BigInt&d);
 
       static mtmath::immut::BigInt gcd(const mtmath::immut::BigInt& a, const mtmath::immut::BigInt& b);
@@ -329,10 +922,10 @@ namespace mtmath {
   }
 }
 
-template <typename RB>
-class std::numeric_limits<mtmath::RationalBase<RB>> {
+template <typename RB, typename Normalization>
+class std::numeric_limits<mtmath::RationalBase<RB, Normalization>> {
 public:
-  using Type = mtmath::RationalBase<RB>;
+  using Type = mtmath::RationalBase<RB, Normalization>;
   static constexpr bool is_specialized = true;
   static constexpr bool is_signed = std::numeric_limits<RB>::is_signed;
   static constexpr bool is_integer = false;
@@ -411,10 +1004,10 @@ public:
   }
 };
 
-template<>
-class std::numeric_limits<mtmath::RationalBase<mtmath::BigInt>> {
+template<typename Normalization>
+class std::numeric_limits<mtmath::RationalBase<mtmath::BigInt, Normalization>> {
 public:
-  using Type = mtmath::RationalBase<mtmath::BigInt>;
+  using Type = mtmath::RationalBase<mtmath::BigInt, Normalization>;
 
 #define MTMATH_RATIONAL_DEF_TRAIT(trait) static constexpr decltype(std::numeric_limits<mtmath::BigInt>:: trait) trait = std::numeric_limits<mtmath::BigInt>:: trait;
 
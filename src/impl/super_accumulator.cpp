@@ -0,0 +1,113 @@
+#include "super_accumulator.h"
+#include <cmath>
+
+void mtmath::SuperAccumulator::add_bits(bool negative, uint64_t mantissa, int64_t exponent) noexcept {
+  auto position = static_cast<size_t>(exponent - MIN_EXPONENT);
+  auto bin = position / BIN_BITS;
+  auto bits = static_cast<unsigned __int128>(mantissa) << (position % BIN_BITS);
+  constexpr uint64_t mask = (uint64_t{1} << BIN_BITS) - 1;
+  // A 53 bit mantissa shifted by under 32 bits spans at most three bins
+  auto low = static_cast<int64_t>(static_cast<uint64_t>(bits) & mask);
+  auto middle = static_cast<int64_t>(static_cast<uint64_t>(bits >> BIN_BITS) & mask);
+  auto high = static_cast<int64_t>(bits >> (2 * BIN_BITS));
+  if (negative) {
+    bins[bin] -= low;
+    bins[bin + 1] -= middle;
+    bins[bin + 2] -= high;
+  }
+  else {
+    bins[bin] += low;
+    bins[bin + 1] += middle;
+    bins[bin + 2] += high;
+  }
+  if (--untilCarry == 0) {
+    propagate_carries(bins);
+    untilCarry = CARRY_INTERVAL;
+  }
+}
+
+void mtmath::SuperAccumulator::propagate_carries(std::array<int64_t, NUM_BINS> &bins) noexcept {
+  // Leaves every bin but the top one in [0, 2^32), the top bin carries the sign
+  for (size_t i = 0; i + 1 < NUM_BINS; ++i) {
+    auto carry = bins[i] >> BIN_BITS;
+    bins[i] -= carry * (int64_t{1} << BIN_BITS);
+    bins[i + 1] += carry;
+  }
+}
+
+mtmath::SuperAccumulator &mtmath::SuperAccumulator::operator+=(double value) noexcept {
+  if (!std::isfinite(value)) {
+    rest += mtmath::Rational::from_double(value);
+    return *this;
+  }
+  auto [negative, mantissa, exponent] = split_double(value);
+  if (mantissa != 0) {
+    add_bits(negative, mantissa, exponent);
+  }
+  return *this;
+}
+
+mtmath::SuperAccumulator &mtmath::SuperAccumulator::operator-=(double value) noexcept {
+  return *this += -value;
+}
+
+mtmath::SuperAccumulator &mtmath::SuperAccumulator::operator+=(const mtmath::Rational &value) {
+  if (!value.is_finite()) {
+    rest += value;
+    return *this;
+  }
+  const auto &numerator = value.numerator();
+  const auto &denominator = value.denominator();
+  if (numerator.is_zero()) {
+    return *this;
+  }
+  auto power = static_cast<int64_t>(denominator.trailing_zeros());
+  // A power of two is the only positive number whose lowest set bit is also its highest
+  if (power <= -MIN_EXPONENT && static_cast<int64_t>(denominator.bit_length()) == power + 1) {
+    dyadic += numerator << static_cast<size_t>(-MIN_EXPONENT - power);
+  }
+  else {
+    rest += value;
+  }
+  return *this;
+}
+
+mtmath::SuperAccumulator &mtmath::SuperAccumulator::operator-=(const mtmath::Rational &value) {
+  return *this += -value;
+}
+
+mtmath::SuperAccumulator &mtmath::SuperAccumulator::operator+=(const mtmath::SuperAccumulator &other) {
+  auto otherBins = other.bins;
+  propagate_carries(otherBins);
+  propagate_carries(bins);
+  for (size_t i = 0; i < NUM_BINS; ++i) {
+    bins[i] += otherBins[i];
+  }
+  // Both sides were below 2^32 per bin, which counts as a single addition
+  untilCarry = CARRY_INTERVAL - 1;
+  dyadic += other.dyadic;
+  rest += other.rest;
+  return *this;
+}
+
+mtmath::Rational mtmath::SuperAccumulator::to_rational() const {
+  auto normalized = bins;
+  propagate_carries(normalized);
+  auto total = mtmath::BigInt{normalized[NUM_BINS - 1]};
+  for (size_t i = NUM_BINS - 1; i > 0; --i) {
+    total <<= BIN_BITS;
+    total += normalized[i - 1];
+  }
+  total += dyadic;
+  if (total.is_zero()) {
+    return rest;
+  }
+  return mtmath::Rational{std::move(total), mtmath::BigInt::one() << static_cast<size_t>(-MIN_EXPONENT)} + rest;
+}
+
+void mtmath::SuperAccumulator::clear() noexcept {
+  bins.fill(0);
+  untilCarry = CARRY_INTERVAL;
+  dyadic = mtmath::BigInt::zero();
+  rest = mtmath::Rational{};
+}
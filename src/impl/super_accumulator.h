@@ -0,0 +1,49 @@
+#pragma once
+
+#include "rational.h"
+#include <array>
+#include <cstdint>
+
+namespace mtmath {
+  /**
+   * Exact sum of doubles and rationals. Doubles are added into a fixed array of 32-bit bins covering every
+   * bit a double can have, so each term costs a few integer additions and no gcd. Rationals with power of two
+   * denominators are kept as one scaled BigInt, anything else falls back to a Rational sum.
+   * The exact total is produced once by to_rational.
+   */
+  class SuperAccumulator {
+  public:
+    SuperAccumulator() = default;
+
+    SuperAccumulator& operator+=(double value) noexcept;
+    SuperAccumulator& operator-=(double value) noexcept;
+    SuperAccumulator& operator+=(const mtmath::Rational& value);
+    SuperAccumulator& operator-=(const mtmath::Rational& value);
+    /** Merges another accumulator, e.g. one filled by another thread */
+    SuperAccumulator& operator+=(const SuperAccumulator& other);
+
+    /** Exact total, reduced to lowest terms */
+    [[nodiscard]] mtmath::Rational to_rational() const;
+
+    void clear() noexcept;
+
+  private:
+    static constexpr int64_t BIN_BITS = 32;
+    // Smallest exponent of a double's odd mantissa (the smallest subnormal is 2^-1074)
+    static constexpr int64_t MIN_EXPONENT = -1074;
+    // Bins span bit 0 through the top of the largest double plus headroom for the carries
+    static constexpr size_t NUM_BINS = 68;
+    // Each addition puts less than 2^32 in a bin, so carries must move up before 2^31 additions
+    static constexpr size_t CARRY_INTERVAL = size_t{1} << 30;
+
+    std::array<int64_t, NUM_BINS> bins = {};
+    size_t untilCarry = CARRY_INTERVAL;
+    // Power of two denominator terms, scaled by 2^-MIN_EXPONENT
+    mtmath::BigInt dyadic = {};
+    // Terms which are not dyadic or are out of range of the bins, including non-finite values
+    mtmath::Rational rest = {};
+
+    void add_bits(bool negative, uint64_t mantissa, int64_t exponent) noexcept;
+    static void propagate_carries(std::array<int64_t, NUM_BINS>& bins) noexcept;
+  };
+}
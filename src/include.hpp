@@ -3,3 +3,9 @@
 #include "impl/byte_array.h"
 #include "impl/big_int.h"
 #include "impl/rational.h"
+#include "impl/hybrid_rational.h"
+#include "impl/super_accumulator.h"
+#include "impl/dyadic.h"
+#include "impl/big_float.h"
+#include "impl/big_decimal.h"
+#include "impl/column_store.h"
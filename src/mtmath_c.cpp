@@ -1,5 +1,6 @@
 #include "mtmath_c.h"
 #include "impl/big_int.h"
+#include <cstring>
 #include <string>
 
 int foo() {
@@ -7,11 +8,19 @@ int foo() {
 }
 
 void set_big_int_to_str_safe(const char *str, unsigned long long strlen, MtMath_BigInt *out) {
-  mtmath::c::into(mtmath::BigInt(std::string{str, static_cast<size_t>(strlen)}), out);
+  auto first = str;
+  auto last = str + strlen;
+  // Matches the string constructor, which also takes a leading '+' and gives zero when there are no digits
+  if (first != last && *first == '+') {
+    ++first;
+  }
+  mtmath::BigInt bi;
+  mtmath::from_chars(first, last, bi);
+  mtmath::c::into(bi, out);
 }
 
 void set_big_int_to_str(const char *str, MtMath_BigInt *out) {
-  mtmath::c::into(mtmath::BigInt(std::string{str}), out);
+  set_big_int_to_str_safe(str, std::strlen(str), out);
 }
 
 void set_big_int_to_int(int val, MtMath_BigInt *out) {
@@ -67,10 +76,8 @@ void add_big_int(const MtMath_BigInt *left, const MtMath_BigInt *right, MtMath_B
   }
 
   mtmath::BigInt tmpLeft;
-  mtmath::BigInt tmpRight;
   mtmath::c::into(*left, &tmpLeft);
-  mtmath::c::into(*right, &tmpRight);
-  tmpLeft += tmpRight;
+  tmpLeft += mtmath::c::view(*right);
   mtmath::c::into(tmpLeft, out);
 }
 
@@ -80,10 +87,8 @@ void sub_big_int(const MtMath_BigInt *left, const MtMath_BigInt *right, MtMath_B
   }
 
   mtmath::BigInt tmpLeft;
-  mtmath::BigInt tmpRight;
   mtmath::c::into(*left, &tmpLeft);
-  mtmath::c::into(*right, &tmpRight);
-  tmpLeft -= tmpRight;
+  tmpLeft -= mtmath::c::view(*right);
   mtmath::c::into(tmpLeft, out);
 }
 
@@ -93,10 +98,8 @@ void mul_big_int(const MtMath_BigInt *left, const MtMath_BigInt *right, MtMath_B
   }
 
   mtmath::BigInt tmpLeft;
-  mtmath::BigInt tmpRight;
   mtmath::c::into(*left, &tmpLeft);
-  mtmath::c::into(*right, &tmpRight);
-  tmpLeft *= tmpRight;
+  tmpLeft *= mtmath::c::view(*right);
   mtmath::c::into(tmpLeft, out);
 }
 
@@ -106,10 +109,8 @@ void div_big_int(const MtMath_BigInt *left, const MtMath_BigInt *right, MtMath_B
 
 void div_rem_big_int(const MtMath_BigInt *left, const MtMath_BigInt *right, MtMath_BigInt *quotient, MtMath_BigInt *remainder) {
   mtmath::BigInt tmpLeft;
-  mtmath::BigInt tmpRight;
   mtmath::c::into(*left, &tmpLeft);
-  mtmath::c::into(*right, &tmpRight);
-  auto [r, q] = tmpLeft.divide(tmpRight);
+  auto [r, q] = tmpLeft.divide(mtmath::c::view(*right));
   if (quotient) {
     mtmath::c::into(q, quotient);
   }
@@ -133,6 +134,26 @@ void set_rational(MtMath_Rational* ra, const MtMath_BigInt* numerator, const MtM
   mtmath::c::into(mtmath::Rational{biNum, biDenom}, ra);
 }
 
+bool set_rational_from_str_safe(const char *str, unsigned long long strlen, MtMath_Rational *out) {
+  if (!str || !out) {
+    return false;
+  }
+
+  auto parsed = mtmath::Rational::parse(std::string_view{str, static_cast<size_t>(strlen)});
+  if (!parsed) {
+    return false;
+  }
+  mtmath::c::into(*parsed, out);
+  return true;
+}
+
+bool set_rational_from_str(const char *str, MtMath_Rational *out) {
+  if (!str) {
+    return false;
+  }
+  return set_rational_from_str_safe(str, std::strlen(str), out);
+}
+
 void add_rational(const MtMath_Rational *left, const MtMath_Rational *right, MtMath_Rational *out) {
   mtmath::Rational rLeft;
   mtmath::Rational rRight;
@@ -176,8 +197,7 @@ long long big_int_ll(const MtMath_BigInt *val) {
 }
 
 void big_int_str_alloc(const MtMath_BigInt *val, char **out) {
-  mtmath::BigInt bi;
-  mtmath::c::into(*val, &bi);
+  auto bi = mtmath::c::view(*val);
   auto str = *bi.to_string(10);
   *out = static_cast<char *>(malloc(sizeof(char) * (str.size() + 1)));
   memcpy(*out, str.c_str(), str.size() + 1);
@@ -187,8 +207,13 @@ void big_int_str(const MtMath_BigInt *val, char *buffer, unsigned long long buff
   if (!buffer || !bufferSize) {
     return;
   }
-  mtmath::BigInt bi;
-  mtmath::c::into(*val, &bi);
+  auto bi = mtmath::c::view(*val);
+  auto [end, ec] = mtmath::to_chars(buffer, buffer + bufferSize - 1, bi);
+  if (ec == std::errc{}) {
+    *end = '\0';
+    return;
+  }
+  // Too small, fall back to writing as much of the number as fits
   auto str = *bi.to_string(10);
   auto resSize = std::min(static_cast<unsigned long long>(str.size() + 1), bufferSize);
   memcpy(buffer, str.c_str(), resSize);
@@ -196,8 +221,7 @@ void big_int_str(const MtMath_BigInt *val, char *buffer, unsigned long long buff
 }
 
 bool big_int_str_alloc_rdx(const MtMath_BigInt *val, char **out, int base) {
-  mtmath::BigInt bi;
-  mtmath::c::into(*val, &bi);
+  auto bi = mtmath::c::view(*val);
   auto strOpt = bi.to_string(base);
   if (!strOpt.has_value()) {
     return false;
@@ -212,8 +236,7 @@ bool big_int_str_rdx(const MtMath_BigInt *val, char *buffer, unsigned long long
   if (!buffer || !bufferSize) {
     return false;
   }
-  mtmath::BigInt bi;
-  mtmath::c::into(*val, &bi);
+  auto bi = mtmath::c::view(*val);
   auto strOpt = bi.to_string(radix);
   if (!strOpt.has_value()) {
     return false;
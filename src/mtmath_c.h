@@ -47,6 +47,9 @@ extern bool big_int_str_alloc_rdx(const MtMath_BigInt* val, char** out, int radi
 extern bool big_int_str_rdx(const MtMath_BigInt* val, char* buffer, unsigned long long bufferSize, int radix);
 
 extern void set_rational(MtMath_Rational* ra, const MtMath_BigInt* numerator, const MtMath_BigInt* denominator);
+/* Parses decimal, scientific or fraction text such as "-12.5", "1.5e-3" or "3/8". Returns false if it is not a number */
+extern bool set_rational_from_str_safe(const char* str, unsigned long long strlen, MtMath_Rational* out);
+extern bool set_rational_from_str(const char* str, MtMath_Rational* out);
 extern void add_rational(const MtMath_Rational* left, const MtMath_Rational* right, MtMath_Rational* out);
 extern void sub_rational(const MtMath_Rational* left, const MtMath_Rational* right, MtMath_Rational* out);
 extern void mul_rational(const MtMath_Rational* left, const MtMath_Rational* right, MtMath_Rational* out);
@@ -0,0 +1,110 @@
+#include "impl/big_decimal.h"
+#include "doctest.h"
+#include <limits>
+#include <sstream>
+
+TEST_SUITE("BigDecimal") {
+  using BI = mtmath::BigInt;
+  using BD = mtmath::BigDecimal;
+  using Mode = mtmath::BigDecimal::RoundingMode;
+  using Rational = mtmath::Rational;
+
+  TEST_CASE("To String") {
+    CHECK_EQ(BD{BI{-1250}, 2}.to_string(), "-12.50");
+    CHECK_EQ(BD{BI{5}, 3}.to_string(), "0.005");
+    CHECK_EQ(BD{BI{-5}, 1}.to_string(), "-0.5");
+    CHECK_EQ(BD{BI{12}, -3}.to_string(), "12000");
+    CHECK_EQ(BD{BI{0}, 2}.to_string(), "0.00");
+    CHECK_EQ(BD{BI::invalid()}.to_string(), "NaN");
+
+    std::stringstream ss;
+    ss << BD{BI{314}, 2};
+    CHECK_EQ(ss.str(), "3.14");
+  }
+
+  TEST_CASE("Add and Subtract") {
+    CHECK_EQ((BD{BI{150}, 2} + BD{BI{225}, 2}).to_string(), "3.75");
+    CHECK_EQ((BD{BI{15}, 1} + BD{BI{225}, 2}).to_string(), "3.75");
+    CHECK_EQ((BD{BI{225}, 2} + BD{BI{15}, 1}).scale(), 2);
+    CHECK_EQ((BD{BI{1}} - BD{BI{1}, 3}).to_string(), "0.999");
+    CHECK_EQ((BD{BI{1}, 1} - BD{BI{2}, 1}).to_string(), "-0.1");
+  }
+
+  TEST_CASE("Multiply") {
+    auto price = BD{BI{1999}, 2};
+    auto rate = BD{BI{75}, 3};
+    CHECK_EQ((price * rate).to_string(), "1.49925");
+    CHECK_EQ((price * BD{BI{-3}}).to_string(), "-59.97");
+
+    // Scales which no longer fit in 32 bits give an invalid value
+    auto tiny = BD{BI{1}, std::numeric_limits<int32_t>::max() - 1};
+    CHECK_EQ((tiny * BD{BI{3}, 1}).scale(), std::numeric_limits<int32_t>::max());
+    CHECK_FALSE((tiny * tiny).is_valid());
+    CHECK_FALSE((BD{BI{1}, std::numeric_limits<int32_t>::min()} * BD{BI{1}, -1}).is_valid());
+  }
+
+  TEST_CASE("Divide") {
+    auto one = BD{BI{1}};
+    auto three = BD{BI{3}};
+    CHECK_EQ(one.divide(three, 4).to_string(), "0.3333");
+    CHECK_EQ(BD{BI{2}}.divide(three, 4).to_string(), "0.6667");
+    CHECK_EQ(BD{BI{2}}.divide(three, 4, Mode::DOWN).to_string(), "0.6666");
+    CHECK_EQ(BD{BI{-2}}.divide(three, 4, Mode::FLOOR).to_string(), "-0.6667");
+    CHECK_EQ(BD{BI{-2}}.divide(three, 4, Mode::CEILING).to_string(), "-0.6666");
+    CHECK_EQ(BD{BI{1}}.divide(three, 0, Mode::UP).to_string(), "1");
+    CHECK_EQ(BD{BI{1000}, 2}.divide(BD{BI{4}, 1}, -1).to_string(), "20");
+    CHECK_EQ(BD{BI{1000}, 2}.divide(BD{BI{4}, 1}, 1).to_string(), "25.0");
+    CHECK_FALSE(one.divide(BD{}, 2).is_valid());
+  }
+
+  TEST_CASE("Rounding Modes") {
+    // Ties and near ties of both signs, in tenths
+    auto rescaled = [](int64_t tenths, Mode mode) { return BD{BI{tenths}, 1}.rescale(0, mode).unscaled(); };
+    CHECK_EQ(rescaled(25, Mode::HALF_EVEN), BI{2});
+    CHECK_EQ(rescaled(35, Mode::HALF_EVEN), BI{4});
+    CHECK_EQ(rescaled(25, Mode::HALF_UP), BI{3});
+    CHECK_EQ(rescaled(-25, Mode::HALF_UP), BI{-3});
+    CHECK_EQ(rescaled(25, Mode::HALF_DOWN), BI{2});
+    CHECK_EQ(rescaled(26, Mode::HALF_DOWN), BI{3});
+    CHECK_EQ(rescaled(21, Mode::UP), BI{3});
+    CHECK_EQ(rescaled(-21, Mode::UP), BI{-3});
+    CHECK_EQ(rescaled(-29, Mode::DOWN), BI{-2});
+    CHECK_EQ(rescaled(-21, Mode::FLOOR), BI{-3});
+    CHECK_EQ(rescaled(21, Mode::CEILING), BI{3});
+    CHECK_EQ(BD{BI{5}}.rescale(3).to_string(), "5.000");
+  }
+
+  TEST_CASE("Rationals") {
+    CHECK_EQ(BD{BI{-1250}, 2}.to_rational(), Rational{-25, 2});
+    CHECK_EQ(BD{BI{3}, -2}.to_rational(), Rational{300});
+    CHECK_EQ(BD::from_rational(Rational{1, 8}, 3).to_string(), "0.125");
+    CHECK_EQ(BD::from_rational(Rational{1, 8}, 2).to_string(), "0.12");
+    CHECK_EQ(BD::from_rational(Rational{1, 8}, 2, Mode::HALF_UP).to_string(), "0.13");
+    CHECK_EQ(BD::from_rational(Rational{-2, 3}, 3).to_string(), "-0.667");
+    CHECK_EQ(BD::from_rational(Rational{1234}, -2).to_string(), "1200");
+    CHECK_FALSE(BD::from_rational(std::numeric_limits<Rational>::infinity(), 2).is_valid());
+    CHECK(BD{BI::invalid()}.to_rational().is_nan());
+  }
+
+  TEST_CASE("Compare") {
+    CHECK_EQ(BD{BI{15}, 1}, BD{BI{150}, 2});
+    CHECK(BD{BI{15}, 1} < BD{BI{151}, 2});
+    CHECK(BD{BI{-15}, 1} < BD{BI{-149}, 2});
+    CHECK(BD{BI{1}, -2} > BD{BI{99}});
+
+    // Widely separated scales compare by size without expanding the smaller scale
+    auto maxScale = std::numeric_limits<int32_t>::max();
+    CHECK(BD{BI{1}, 320000} < BD{BI{1}});
+    CHECK(BD{BI{1}, maxScale} < BD{BI{1}, std::numeric_limits<int32_t>::min()});
+    CHECK(BD{BI{-1}, maxScale} > BD{BI{-1}});
+    CHECK(BD{BI{-1}, maxScale} < BD{BI{0}, 3});
+    CHECK(BD{BI{0}, maxScale} == BD{BI{0}});
+
+    // Aligning far apart scales builds the power of ten by squaring
+    auto sum = BD{BI{1}, 200000} + BD{BI{1}};
+    CHECK_EQ(sum.scale(), 200000);
+    CHECK_EQ(sum.rescale(0), BD{BI{1}});
+    CHECK(sum > BD{BI{1}});
+    CHECK_EQ(sum.to_rational() - Rational{1}, BD{BI{1}, 200000}.to_rational());
+  }
+}
@@ -0,0 +1,84 @@
+#include "impl/big_float.h"
+#include "doctest.h"
+#include <limits>
+
+TEST_SUITE("BigFloat") {
+  using BI = mtmath::BigInt;
+  using BF = mtmath::BigFloat;
+  using Mode = mtmath::BigFloat::RoundingMode;
+  using Rational = mtmath::Rational;
+
+  TEST_CASE("Rounds to precision") {
+    CHECK_EQ(BF{BI{255}, 4}.to_rational(), Rational{256});
+    CHECK_EQ(BF{BI{255}, 4, Mode::TOWARD_ZERO}.to_rational(), Rational{240});
+    CHECK_EQ(BF{BI{-255}, 4, Mode::UPWARD}.to_rational(), Rational{-240});
+    CHECK_EQ(BF{BI{-241}, 4, Mode::DOWNWARD}.to_rational(), Rational{-256});
+    // Ties go to the even neighbour
+    CHECK_EQ(BF{BI{9}, 3}.to_rational(), Rational{8});
+    CHECK_EQ(BF{BI{11}, 3}.to_rational(), Rational{12});
+    CHECK_EQ(BF{BI{11}, 3}.precision(), 3);
+    CHECK_EQ(BF{BI{1023}, 64}.with_precision(2).to_rational(), Rational{1024});
+  }
+
+  TEST_CASE("Arithmetic") {
+    auto third = BF::from_rational(Rational{1, 3}, 64);
+    CHECK_EQ(third.to_double(), 1.0 / 3.0);
+    CHECK_EQ((third + third + third).to_rational(), Rational{1});
+    CHECK_EQ((BF{BI{3}, 64} * third).to_rational(), Rational{1});
+    CHECK_EQ((BF{BI{1}, 64} / BF{BI{3}, 64}), third);
+    CHECK_EQ((BF{BI{7}, 64} - BF{BI{7}, 64}).to_rational(), Rational{0});
+
+    // Far apart operands round as if added exactly
+    auto big = BF{BI{1} << 1000, 53};
+    auto tiny = BF::from_double(0x1p-1000, 53);
+    CHECK_EQ(big + tiny, big);
+    CHECK_EQ((big + tiny).with_precision(53, Mode::UPWARD).to_rational(), big.to_rational());
+    CHECK_EQ(big.with_precision(53, Mode::UPWARD) + tiny, BF{(BI{1} << 1000) + (BI{1} << 948), 53});
+    CHECK_EQ(big.with_precision(53, Mode::TOWARD_ZERO) - tiny, BF{(BI{1} << 1000) - (BI{1} << 947), 53});
+
+    // Sizes stay bounded by the precision
+    auto x = BF::from_rational(Rational{10, 7}, 128);
+    for (int i = 0; i < 50; ++i) {
+      x = x * x / BF{BI{2}, 128};
+    }
+    CHECK(x.dyadic().mantissa().bit_length() <= 128);
+  }
+
+  TEST_CASE("Square roots") {
+    auto two = BF{BI{2}, 200};
+    auto root = two.sqrt();
+    CHECK_EQ(root.precision(), 200);
+    CHECK_EQ(root.to_double(), 1.4142135623730951);
+    CHECK_EQ((root * root).with_precision(190), two);
+    CHECK_EQ(BF{BI{144}}.sqrt().to_rational(), Rational{12});
+    CHECK_EQ(BF::from_double(0.25).sqrt().to_rational(), Rational{1, 2});
+    CHECK(BF{BI{-4}}.sqrt().is_nan());
+    CHECK(BF{}.sqrt().is_zero());
+  }
+
+  TEST_CASE("Compare") {
+    CHECK(BF{BI{1}} < BF{BI{2}});
+    CHECK(BF::from_double(-0.5) < BF{});
+    CHECK(BF::infinity(true) < BF::from_double(-1e300));
+    CHECK(BF::infinity() > BF::from_double(1e300));
+    CHECK_FALSE(BF::nan() == BF::nan());
+    CHECK_EQ(BF::nan() <=> BF{}, std::partial_ordering::unordered);
+  }
+
+  TEST_CASE("Special values") {
+    auto inf = BF::infinity();
+    CHECK((inf + BF{BI{1}}).is_infinite());
+    CHECK((inf - inf).is_nan());
+    CHECK((inf * BF{}).is_nan());
+    CHECK((inf * BF{BI{-1}}).is_negative());
+    CHECK((BF{BI{1}} / BF{}).is_infinite());
+    CHECK((BF{BI{-1}} / BF{}).is_negative());
+    CHECK((BF{} / BF{}).is_nan());
+    CHECK((BF{BI{1}} / inf).is_zero());
+    CHECK(BF::from_double(std::numeric_limits<double>::quiet_NaN()).is_nan());
+    CHECK(BF::from_rational(std::numeric_limits<Rational>::infinity()).is_infinite());
+    CHECK(BF{BI::invalid()}.is_nan());
+    CHECK(BF::infinity(true).to_rational().is_neg_infinity());
+    CHECK_EQ(BF::infinity(true).to_double(), -std::numeric_limits<double>::infinity());
+  }
+}
@@ -1,5 +1,7 @@
 #include "impl/big_int.h"
 #include "doctest.h"
+#include <array>
+#include <cmath>
 
 TEST_SUITE("BigInt") {
   TEST_CASE("To String") {
@@ -118,6 +120,8 @@ TEST_SUITE("BigInt") {
     CHECK_EQ(mtmath::BigInt(1485209) += mtmath::BigInt("934889"), mtmath::BigInt("2420098"));
     CHECK_EQ(mtmath::BigInt(1485209) + mtmath::BigInt("-934889"), mtmath::BigInt("550320"));
     CHECK_EQ(mtmath::BigInt(-1485209) += mtmath::BigInt("934889"), mtmath::BigInt("-550320"));
+    // Carry out of the top byte when the right side is shorter
+    CHECK_EQ(mtmath::BigInt("18446744073709551610") += mtmath::BigInt("1714876512"), mtmath::BigInt("18446744075424428122"));
 
     CHECK_EQ(mtmath::BigInt::invalid() + mtmath::BigInt("-2"), mtmath::BigInt::invalid());
     CHECK_EQ(mtmath::BigInt(-1485209) + mtmath::BigInt::invalid(), mtmath::BigInt::invalid());
@@ -133,6 +137,51 @@ TEST_SUITE("BigInt") {
     CHECK_EQ(mtmath::BigInt(-1485209) - mtmath::BigInt::invalid(), mtmath::BigInt::invalid());
   }
 
+  TEST_CASE("Carries Across Words") {
+    using BI = mtmath::BigInt;
+    // Carries and borrows ripple through whole words and the ragged top bytes
+    for (size_t bits : {8, 64, 72, 128, 200}) {
+      CAPTURE(bits);
+      auto ones = (BI{1} << bits) - BI{1};
+      CHECK_EQ(ones + BI{1}, BI{1} << bits);
+      CHECK_EQ((BI{1} << bits) - ones, BI{1});
+      CHECK_EQ(BI{1} - (BI{1} << bits), -ones);
+      auto doubled = ones;
+      doubled += doubled.view();
+      CHECK_EQ(doubled, ones << 1);
+      CHECK_LT(ones, ones + BI{1});
+      CHECK_GT(ones << 8, (ones << 8) - BI{1});
+    }
+  }
+
+  TEST_CASE("Capacity") {
+    using BI = mtmath::BigInt;
+    auto x = BI{1} << 800;
+    auto capacity = x.capacity();
+    REQUIRE_GE(capacity, 101);
+    // Shrinking keeps the storage and growing back into it does not reallocate
+    x -= (BI{1} << 800) - BI{5};
+    CHECK_EQ(x, BI{5});
+    CHECK_EQ(x.capacity(), capacity);
+    x -= BI{1} << 700;
+    CHECK_EQ(x, BI{5} - (BI{1} << 700));
+    CHECK_EQ(x.capacity(), capacity);
+
+    x.shrink();
+    CHECK_EQ(x, BI{5} - (BI{1} << 700));
+    CHECK_LT(x.capacity(), capacity);
+    x.reserve(400);
+    CHECK_GE(x.capacity(), 400);
+    CHECK_EQ(x, BI{5} - (BI{1} << 700));
+
+    // Shifting zero does not grow storage
+    auto zero = BI::zero();
+    zero <<= 1ull << 20;
+    CHECK(zero.is_zero());
+    CHECK_EQ(zero.capacity(), 0);
+    CHECK_EQ((BI::zero() << (1ull << 20)).capacity(), 0);
+  }
+
   TEST_CASE("Bit Shift") {
     CHECK_EQ(mtmath::BigInt(1) << 2, mtmath::BigInt(4));
     CHECK_EQ(mtmath::BigInt(4) >> 2, mtmath::BigInt(1));
@@ -157,6 +206,9 @@ TEST_SUITE("BigInt") {
 
     CHECK_EQ(mtmath::BigInt(1484209) <=> mtmath::BigInt(-1485208), std::strong_ordering::greater);
     CHECK_EQ(mtmath::BigInt(-1485208) <=> mtmath::BigInt(1484209), std::strong_ordering::less);
+    CHECK_EQ(mtmath::BigInt(-1485208) <=> mtmath::BigInt(-1484209), std::strong_ordering::less);
+    CHECK_EQ(mtmath::BigInt(-1484209) <=> mtmath::BigInt(-1485208), std::strong_ordering::greater);
+    CHECK_EQ(mtmath::BigInt(-1485208) <=> mtmath::BigInt(-1485208), std::strong_ordering::equal);
   }
 
   TEST_CASE("Compare operators") {
@@ -209,6 +261,7 @@ TEST_SUITE("BigInt") {
     CHECK_EQ((mtmath::BigInt(-1485209) * mtmath::BigInt("-2")).to_string(16), "0x2d5332");
 
     CHECK_EQ((mtmath::BigInt(250) * mtmath::BigInt("250")).to_string(10), "62500");
+    CHECK_EQ((mtmath::BigInt(65535) * mtmath::BigInt(65535)).to_string(10), "4294836225");
 
     CHECK_EQ(mtmath::BigInt::zero() * mtmath::BigInt("-2"), mtmath::BigInt::zero());
     CHECK_EQ(mtmath::BigInt(-1485209) * mtmath::BigInt::zero(), mtmath::BigInt::zero());
@@ -229,6 +282,78 @@ TEST_SUITE("BigInt") {
     CHECK_FALSE((mtmath::BigInt::invalid() / mtmath::BigInt(1485209)).is_valid());
   }
 
+  TEST_CASE("Exact Divide") {
+    using BI = mtmath::BigInt;
+    CHECK_EQ(BI{1485209 * 3}.divexact(BI{3}), BI{1485209});
+    CHECK_EQ(BI{-1485209 * 4}.divexact(BI{4}), BI{-1485209});
+    CHECK_EQ(BI{1485209 * 12}.divexact(BI{-12}), BI{-1485209});
+    CHECK_EQ(BI::zero().divexact(BI{7}), BI::zero());
+    CHECK_FALSE(BI{7}.divexact(BI::zero()).is_valid());
+    CHECK_FALSE(BI::invalid().divexact(BI{7}).is_valid());
+
+    auto a = BI{"340282366920938463463374607431768211297"};
+    auto b = BI{"-18446744073709551616"} * BI{"98765432109876543210987654321"};
+    auto product = a * a * b;
+    CHECK_EQ(product.divexact(b), a * a);
+    CHECK_EQ(product.divexact(a), a * b);
+  }
+
+  TEST_CASE("Machine Integer Operands") {
+    using BI = mtmath::BigInt;
+    auto big = BI{"340282366920938463463374607431768211297"};
+    CHECK_EQ(big + 5, big + BI{5});
+    CHECK_EQ(big - 5u, big - BI{5});
+    CHECK_EQ(big * -7, big * BI{-7});
+    CHECK_EQ(big / uint64_t{18446744073709551615u}, big / BI{"18446744073709551615"});
+    CHECK_EQ(big % 1000, BI{297});
+    CHECK_EQ(-big % 1000, BI{-297});
+    CHECK_EQ(BI{-7} % 2, BI{-7} % BI{2});
+    CHECK_EQ(BI{-7} / 2, BI{-3});
+
+    // Word kernels over ragged multi-word magnitudes, with divisors needing every normalization shift
+    auto wide = (big << 77) + BI{"98765432109876543210"};
+    for (uint64_t d : {uint64_t{3}, uint64_t{0x0100000000000001}, uint64_t{0x8000000000000000}, uint64_t{0xfedcba9876543211}}) {
+      CAPTURE(d);
+      auto bd = BI{std::to_string(d)};
+      CHECK_EQ(wide / d, wide / bd);
+      CHECK_EQ(wide % d, wide % bd);
+      CHECK_EQ(wide * d, wide * bd);
+      CHECK_EQ(wide + d, wide + bd);
+    }
+
+    // Crossing zero flips the sign
+    CHECK_EQ(BI{3} - 10, BI{-7});
+    CHECK_EQ(BI{-3} + 10, BI{7});
+    CHECK_EQ(BI{-3} + 3, BI::zero());
+    CHECK_EQ(BI::zero() - std::numeric_limits<int64_t>::min(), BI{"9223372036854775808"});
+    CHECK_EQ(BI{"18446744073709551615"} + 1, BI{"18446744073709551616"});
+    CHECK_EQ(BI{"18446744073709551616"} - 1, BI{"18446744073709551615"});
+
+    CHECK_FALSE((big / 0).is_valid());
+    CHECK_FALSE((big % 0).is_valid());
+    CHECK_FALSE((BI::invalid() + 1).is_valid());
+
+    CHECK(big > 0);
+    CHECK(-big < 0);
+    CHECK(0 < big);
+    CHECK(BI{-5} == -5);
+    CHECK(BI{-5} < -4);
+    CHECK(BI{-5} > -6);
+    CHECK(BI::zero() == 0u);
+    CHECK(big > std::numeric_limits<uint64_t>::max());
+    CHECK(-big < std::numeric_limits<int64_t>::min());
+
+    auto acc = BI{-10};
+    acc += 25;
+    acc *= 4u;
+    acc -= 100;
+    CHECK_EQ(acc, BI{-40});
+    acc /= -8;
+    CHECK_EQ(acc, BI{5});
+    acc %= 3;
+    CHECK_EQ(acc, BI{2});
+  }
+
   TEST_CASE("Modulo") {
     std::string s = (mtmath::BigInt(1485209) % mtmath::BigInt("2")).to_string(16).value();
     CHECK_EQ(s, "0x1");
@@ -238,6 +363,78 @@ TEST_SUITE("BigInt") {
     CHECK_EQ(mtmath::BigInt(1485211) %= mtmath::BigInt("3"), mtmath::BigInt("1"));
   }
 
+  TEST_CASE("GCD") {
+    using BI = mtmath::BigInt;
+    CHECK_EQ(BI::gcd(BI{48}, BI{18}), BI{6});
+    CHECK_EQ(BI::gcd(BI{-48}, BI{18}), BI{6});
+    CHECK_EQ(BI::gcd(BI{48}, BI{-18}), BI{6});
+    CHECK_EQ(BI::gcd(BI{17}, BI{5}), BI{1});
+    CHECK_EQ(BI::gcd(BI::zero(), BI{-5}), BI{5});
+    CHECK_EQ(BI::gcd(BI{5}, BI::zero()), BI{5});
+    CHECK_EQ(BI::gcd(BI::zero(), BI::zero()), BI::zero());
+    CHECK_FALSE(BI::gcd(BI::invalid(), BI{5}).is_valid());
+    CHECK_FALSE(BI::gcd(BI{5}, BI::invalid()).is_valid());
+
+    // Large enough to go through the Lehmer and half-gcd paths
+    auto pow = [](int64_t base, int exp) {
+      auto res = BI::one();
+      for (int i = 0; i < exp; ++i) {
+        res *= BI{base};
+      }
+      return res;
+    };
+    auto common = pow(3, 3000) * pow(7, 1000);
+    auto a = common * pow(5, 3000);
+    auto b = common * pow(11, 2000) + common;
+    CHECK_EQ(BI::gcd(a, b), common);
+    CHECK_EQ(BI::gcd(b, a), common);
+    CHECK_EQ(BI::gcd(pow(2, 3000) * pow(3, 500), pow(2, 1000) * pow(3, 900)), pow(2, 1000) * pow(3, 500));
+  }
+
+  TEST_CASE("Extended GCD") {
+    using BI = mtmath::BigInt;
+    auto check = [](const BI& a, const BI& b, const BI& expected) {
+      auto [g, s, t] = BI::gcdext(a, b);
+      CHECK_EQ(g, expected);
+      CHECK_EQ(s * a + t * b, g);
+    };
+    check(BI{240}, BI{46}, BI{2});
+    check(BI{46}, BI{240}, BI{2});
+    check(BI{-240}, BI{46}, BI{2});
+    check(BI{240}, BI{-46}, BI{2});
+    check(BI{17}, BI{17}, BI{17});
+    check(BI::zero(), BI{-5}, BI{5});
+    check(BI{-5}, BI::zero(), BI{5});
+    check(BI::zero(), BI::zero(), BI::zero());
+
+    auto big = BI{"340282366920938463463374607431768211297"};
+    auto common = big * big * big;
+    for (int i = 0; i < 6; ++i) {
+      common = common * common + BI{i};
+    }
+    check(common * BI{"18446744073709551629"}, common * (big + BI{2}), common);
+
+    auto [g, s, t] = BI::gcdext(BI::invalid(), BI{5});
+    CHECK_FALSE(g.is_valid());
+    CHECK_FALSE(s.is_valid());
+    CHECK_FALSE(t.is_valid());
+  }
+
+  TEST_CASE("Modular Inverse") {
+    using BI = mtmath::BigInt;
+    CHECK_EQ(BI::invmod(BI{3}, BI{11}), BI{4});
+    CHECK_EQ(BI::invmod(BI{-3}, BI{11}), BI{7});
+    CHECK_EQ(BI::invmod(BI{3}, BI{-11}), BI{4});
+    CHECK_EQ(BI::invmod(BI{5}, BI{1}), BI::zero());
+    CHECK_FALSE(BI::invmod(BI{4}, BI{8}).is_valid());
+    CHECK_FALSE(BI::invmod(BI{4}, BI::zero()).is_valid());
+    CHECK_FALSE(BI::invmod(BI::invalid(), BI{7}).is_valid());
+
+    auto prime = BI{"170141183460469231731687303715884105727"};
+    auto a = BI{"98765432109876543210987654321"};
+    CHECK_EQ((BI::invmod(a, prime) * a) % prime, BI::one());
+  }
+
   TEST_CASE("Numeric Properties") {
     using BI = mtmath::BigInt;
     using nl = std::numeric_limits<BI>;
@@ -275,6 +472,233 @@ TEST_SUITE("BigInt") {
     CHECK_EQ(nl::denorm_min(), BI::zero());
   }
 
+  TEST_CASE("Doubles") {
+    using BI = mtmath::BigInt;
+    CHECK_EQ(BI::from_double(1485209.75), BI{1485209});
+    CHECK_EQ(BI::from_double(-1485209.75), BI{-1485209});
+    CHECK_EQ(BI::from_double(0.5), BI::zero());
+    CHECK_EQ(BI::from_double(0x1p100), BI{1} << 100);
+    CHECK_FALSE(BI::from_double(std::numeric_limits<double>::infinity()).is_valid());
+    CHECK_FALSE(BI::from_double(std::numeric_limits<double>::quiet_NaN()).is_valid());
+
+    CHECK_EQ(BI{1485209}.to_double(), 1485209.0);
+    CHECK_EQ(BI{-1485209}.to_double(), -1485209.0);
+    CHECK_EQ(BI::zero().to_double(), 0.0);
+    CHECK_EQ(BI{3}.to_double(-2), 0.75);
+    // Halfway cases round to even, anything past halfway rounds up
+    CHECK_EQ(((BI{1} << 53) + 1).to_double(), 0x1p53);
+    CHECK_EQ(((BI{1} << 53) + 3).to_double(), 0x1p53 + 4);
+    CHECK_EQ(((BI{1} << 200) + (BI{1} << 147)).to_double(), 0x1p200);
+    CHECK_EQ(((BI{1} << 200) + (BI{1} << 147) + 1).to_double(), 0x1p200 + 0x1p148);
+    CHECK_EQ((BI{1} << 1024).to_double(), std::numeric_limits<double>::infinity());
+    CHECK_EQ(BI{1}.to_double(-1074), std::numeric_limits<double>::denorm_min());
+    CHECK_EQ(BI{1}.to_double(-1075), 0.0);
+    CHECK(std::isnan(BI::invalid().to_double()));
+  }
+
+  TEST_CASE("Trailing Zeros") {
+    using BI = mtmath::BigInt;
+    CHECK_EQ(BI::zero().trailing_zeros(), 0);
+    CHECK_EQ(BI{1}.trailing_zeros(), 0);
+    CHECK_EQ(BI{-96}.trailing_zeros(), 5);
+    CHECK_EQ((BI{3} << 200).trailing_zeros(), 200);
+  }
+
+  TEST_CASE("Bitwise") {
+    using BI = mtmath::BigInt;
+    auto big = (BI{1} << 100) + BI{0xff};
+    CHECK_EQ(BI{12} & BI{10}, BI{8});
+    CHECK_EQ(BI{12} | BI{10}, BI{14});
+    CHECK_EQ(BI{12} ^ BI{10}, BI{6});
+    // Negatives act as two's complement with infinitely many leading ones
+    CHECK_EQ(BI{-12} & BI{10}, BI{0});
+    CHECK_EQ(BI{-12} & BI{0xff}, BI{0xf4});
+    CHECK_EQ(BI{-12} | BI{10}, BI{-2});
+    CHECK_EQ(BI{-12} ^ BI{-10}, BI{2});
+    CHECK_EQ(BI{-1} & big, big);
+    CHECK_EQ(-big & -big, -big);
+    CHECK_EQ(-(BI{1} << 64) | (BI{1} << 64), -(BI{1} << 64));
+    CHECK_EQ(~BI{0}, BI{-1});
+    CHECK_EQ(~BI{-1}, BI{0});
+    CHECK_EQ(~big, -big - BI{1});
+    CHECK_FALSE((BI{1} & BI::invalid()).is_valid());
+
+    auto acc = big;
+    acc &= acc.view();
+    CHECK_EQ(acc, big);
+    acc ^= BI{0xff};
+    CHECK_EQ(acc, BI{1} << 100);
+  }
+
+  TEST_CASE("Bit Queries") {
+    using BI = mtmath::BigInt;
+    CHECK(BI{5}.test_bit(0));
+    CHECK_FALSE(BI{5}.test_bit(1));
+    CHECK_FALSE(BI{5}.test_bit(1000));
+    // -8 is ...11111000
+    CHECK_FALSE(BI{-8}.test_bit(2));
+    CHECK(BI{-8}.test_bit(3));
+    CHECK(BI{-8}.test_bit(1000));
+    CHECK(BI{-9}.test_bit(0));
+    CHECK_FALSE(BI{-9}.test_bit(3));
+
+    auto value = BI{0};
+    value.set_bit(130);
+    CHECK_EQ(value, BI{1} << 130);
+    value.set_bit(130, false);
+    CHECK(value.is_zero());
+    value = BI{-8};
+    value.set_bit(1);
+    CHECK_EQ(value, BI{-6});
+    value.set_bit(3, false);
+    CHECK_EQ(value, BI{-14});
+
+    CHECK_EQ(BI{0}.popcount(), 0);
+    CHECK_EQ(BI{-7}.popcount(), 3);
+    CHECK_EQ(((BI{1} << 200) - BI{1}).popcount(), 200);
+    CHECK_EQ(BI::invalid().popcount(), 0);
+  }
+
+  TEST_CASE("Chars") {
+    using BI = mtmath::BigInt;
+    char buffer[128];
+    auto write = [&](const BI& value, int base) {
+      auto [end, ec] = mtmath::to_chars(buffer, buffer + sizeof(buffer), value, base);
+      REQUIRE(ec == std::errc{});
+      CHECK(static_cast<size_t>(end - buffer) <= mtmath::to_chars_size(value, base));
+      return std::string{buffer, end};
+    };
+    auto big = BI{"-123456789012345678901234567890123456789"};
+    CHECK_EQ(write(big, 10), "-123456789012345678901234567890123456789");
+    CHECK_EQ(write(BI{255}, 16), "ff");
+    CHECK_EQ(write(BI{-5}, 2), "-101");
+    CHECK_EQ(write(BI{35}, 36), "z");
+    CHECK_EQ(write(BI{1} << 64, 32), "g000000000000");
+    CHECK_EQ(write(BI::zero(), 10), "0");
+    CHECK_EQ(write(BI::invalid(), 10), "NaN");
+    CHECK_EQ(mtmath::to_chars_size(BI{255}, 16), 2);
+    CHECK_EQ(mtmath::to_chars_size(BI{-5}, 2), 4);
+    CHECK_EQ(mtmath::to_chars_size(BI{1000}, 10), 4);
+
+    // Fails cleanly when the digits do not fit, even with room for the magnitude
+    CHECK(mtmath::to_chars(buffer, buffer + 39, big, 10).ec == std::errc::value_too_large);
+    CHECK(mtmath::to_chars(buffer, buffer + 40, big, 10).ec == std::errc{});
+    CHECK(mtmath::to_chars(buffer, buffer + 1, BI{256}, 16).ec == std::errc::value_too_large);
+    CHECK(mtmath::to_chars(buffer, buffer + 8, big, 37).ec == std::errc::invalid_argument);
+
+    BI parsed;
+    std::string_view text = "-123456789012345678901234567890123456789 rest";
+    auto [ptr, ec] = mtmath::from_chars(text.data(), text.data() + text.size(), parsed);
+    CHECK(ec == std::errc{});
+    CHECK_EQ(std::string_view{ptr}, " rest");
+    CHECK_EQ(parsed, big);
+    text = "fF";
+    mtmath::from_chars(text.data(), text.data() + text.size(), parsed, 16);
+    CHECK_EQ(parsed, BI{255});
+    text = "-0";
+    mtmath::from_chars(text.data(), text.data() + text.size(), parsed);
+    CHECK_EQ(parsed, BI::zero());
+    CHECK_FALSE(parsed.is_negative());
+    text = "-x";
+    CHECK(mtmath::from_chars(text.data(), text.data() + text.size(), parsed).ec == std::errc::invalid_argument);
+    CHECK_EQ(parsed, BI::zero());
+  }
+
+  TEST_CASE("Serialization") {
+    using BI = mtmath::BigInt;
+    std::array<std::byte, 64> buffer{};
+    auto value = BI{-300};
+    CHECK_EQ(value.serialized_size(), 4);
+    REQUIRE_EQ(value.serialize(buffer), 4);
+    // Version and sign, length 2, then 300 little-endian
+    CHECK_EQ(buffer[0], std::byte{0x5});
+    CHECK_EQ(buffer[1], std::byte{2});
+    CHECK_EQ(buffer[2], std::byte{0x2c});
+    CHECK_EQ(buffer[3], std::byte{0x1});
+
+    // Values written back to back read back in order
+    auto big = BI{1} << 1000;
+    auto offset = value.serialize(buffer);
+    auto bigBuffer = std::vector<std::byte>(offset + big.serialized_size() + BI::invalid().serialized_size());
+    std::copy_n(buffer.begin(), offset, bigBuffer.begin());
+    offset += big.serialize(std::span{bigBuffer}.subspan(offset));
+    offset += BI::invalid().serialize(std::span{bigBuffer}.subspan(offset));
+    CHECK_EQ(offset, bigBuffer.size());
+    CHECK_EQ(BI{1000}.serialize(std::span{buffer}.first(2)), 0);
+
+    size_t consumed = 0;
+    auto in = std::span<const std::byte>{bigBuffer};
+    CHECK_EQ(BI::deserialize(in, &consumed), value);
+    in = in.subspan(consumed);
+    auto view = mtmath::BigIntView::deserialize(in, &consumed);
+    REQUIRE(view.has_value());
+    CHECK_EQ(view->magnitude().data(), reinterpret_cast<const uint8_t*>(in.data() + 2));
+    CHECK_EQ(BI{*view}, big);
+    in = in.subspan(consumed);
+    CHECK_FALSE(BI::deserialize(in)->is_valid());
+
+    CHECK_EQ(BI::deserialize(std::span{buffer}.first(BI::zero().serialize(buffer))), BI::zero());
+    // Truncated, wrong version, leading zero byte
+    CHECK_FALSE(BI::deserialize(std::span{bigBuffer}.subspan(4, 10)).has_value());
+    CHECK_FALSE(BI::deserialize(std::array{std::byte{0x9}, std::byte{0}}).has_value());
+    CHECK_FALSE(BI::deserialize(std::array{std::byte{0x4}, std::byte{1}, std::byte{0}}).has_value());
+    // Overlong length, and a length with bits past the top of a size_t that would otherwise wrap to 0
+    CHECK_FALSE(BI::deserialize(std::array{std::byte{0x4}, std::byte{0x81}, std::byte{0}, std::byte{1}}).has_value());
+    auto wrapped = std::vector<std::byte>(9, std::byte{0x80});
+    wrapped.insert(wrapped.begin(), std::byte{0x4});
+    wrapped.push_back(std::byte{0x2});
+    CHECK_FALSE(BI::deserialize(wrapped).has_value());
+    CHECK_EQ(BI::deserialize(std::array{std::byte{0x4}, std::byte{1}, std::byte{1}}), BI{1});
+  }
+
+  TEST_CASE("Views") {
+    using BI = mtmath::BigInt;
+    // 2^72 - 1 and -300, viewed straight out of buffers
+    auto ones = std::array<uint8_t, 9>{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+    auto small = std::array<uint8_t, 2>{0x2c, 0x1};
+    auto big = mtmath::BigIntView{ones};
+    auto negative = mtmath::BigIntView{small, true};
+    auto bigValue = (BI{1} << 72) - BI{1};
+
+    auto sum = BI{1};
+    sum += big;
+    CHECK_EQ(sum, BI{1} << 72);
+    sum -= big;
+    CHECK_EQ(sum, BI{1});
+    CHECK_EQ(BI{5} + negative, BI{-295});
+    CHECK_EQ(BI{-5} - negative, BI{295});
+    CHECK_EQ(BI{500} - negative, BI{800});
+    CHECK_EQ(BI{3} * negative, BI{-900});
+    CHECK_EQ(bigValue / negative, bigValue / BI{-300});
+    CHECK_EQ(bigValue % negative, bigValue % BI{-300});
+    CHECK_EQ(BI{-900}.divexact(negative), BI{3});
+    auto [r, q] = BI{-301}.divide(negative);
+    CHECK_EQ(r, BI{-1});
+    CHECK_EQ(q, BI{1});
+    CHECK_EQ(BI::gcd(mtmath::BigIntView{small}, BI{1050}.view()), BI{150});
+
+    CHECK_EQ(bigValue, big);
+    CHECK(BI{-301} < negative);
+    CHECK(BI{-299} > negative);
+    CHECK(big > BI{-1});
+    CHECK_EQ(big.to_string(16), "0xffffffffffffffffff");
+    CHECK_EQ(negative.to_string(10), "-300");
+    CHECK_EQ(negative.to_string(16), "-0x12c");
+    CHECK_EQ(mtmath::BigIntView{}.to_string(16), "0x0");
+    CHECK_EQ(mtmath::BigIntView{{}, false, false}.to_string(10), "NaN");
+    CHECK_FALSE((BI{1} + mtmath::BigIntView{{}, false, false}).is_valid());
+    CHECK_FALSE(std::get<1>(BI{1}.divide(mtmath::BigIntView{})).is_valid());
+
+    // Operands may view the value being updated
+    auto doubled = bigValue;
+    doubled += doubled.view();
+    CHECK_EQ(doubled, bigValue * BI{2});
+    doubled -= doubled.view();
+    CHECK(doubled.is_zero());
+    CHECK_EQ(bigValue.view().to_string(10), bigValue.to_string(10));
+    CHECK_EQ(bigValue.to_immut().view().to_string(10), bigValue.to_string(10));
+  }
+
   TEST_CASE("Abs Values") {
     using BI = mtmath::BigInt;
     CHECK_EQ(BI{"1234"}.abs_val(), BI{"1234"});
@@ -435,6 +859,9 @@ TEST_SUITE("immut BigInt") {
 
     CHECK_EQ(mtmath::immut::BigInt(1484209) <=> mtmath::immut::BigInt(-1485208), std::strong_ordering::greater);
     CHECK_EQ(mtmath::immut::BigInt(-1485208) <=> mtmath::immut::BigInt(1484209), std::strong_ordering::less);
+    CHECK_EQ(mtmath::immut::BigInt(-1485208) <=> mtmath::immut::BigInt(-1484209), std::strong_ordering::less);
+    CHECK_EQ(mtmath::immut::BigInt(-1484209) <=> mtmath::immut::BigInt(-1485208), std::strong_ordering::greater);
+    CHECK_EQ(mtmath::immut::BigInt(-1485208) <=> mtmath::immut::BigInt(-1485208), std::strong_ordering::equal);
   }
 
   TEST_CASE("Compare operators") {
@@ -487,6 +914,7 @@ TEST_SUITE("immut BigInt") {
     CHECK_EQ((mtmath::immut::BigInt(-1485209) * mtmath::immut::BigInt("-2")).to_string(16), "0x2d5332");
 
     CHECK_EQ((mtmath::immut::BigInt(250) * mtmath::immut::BigInt("250")).to_string(10), "62500");
+    CHECK_EQ((mtmath::immut::BigInt(65535) * mtmath::immut::BigInt(65535)).to_string(10), "4294836225");
 
     CHECK_EQ(mtmath::immut::BigInt::zero() * mtmath::immut::BigInt("-2"), mtmath::immut::BigInt::zero());
     CHECK_EQ(mtmath::immut::BigInt(-1485209) * mtmath::immut::BigInt::zero(), mtmath::immut::BigInt::zero());
@@ -506,6 +934,57 @@ TEST_SUITE("immut BigInt") {
     CHECK_FALSE((mtmath::immut::BigInt::invalid() / mtmath::immut::BigInt(1485209)).is_valid());
   }
 
+  TEST_CASE("Exact Divide") {
+    using BI = mtmath::immut::BigInt;
+    CHECK_EQ(BI{1485209 * 3}.divexact(BI{3}), BI{1485209});
+    CHECK_EQ(BI{-1485209 * 4}.divexact(BI{4}), BI{-1485209});
+    CHECK_EQ(BI{1485209 * 12}.divexact(BI{-12}), BI{-1485209});
+    CHECK_EQ(BI::zero().divexact(BI{7}), BI::zero());
+    CHECK_FALSE(BI{7}.divexact(BI::zero()).is_valid());
+    CHECK_FALSE(BI::invalid().divexact(BI{7}).is_valid());
+
+    auto a = BI{"340282366920938463463374607431768211297"};
+    auto b = BI{"-18446744073709551616"} * BI{"98765432109876543210987654321"};
+    auto product = a * a * b;
+    CHECK_EQ(product.divexact(b), a * a);
+    CHECK_EQ(product.divexact(a), a * b);
+  }
+
+  TEST_CASE("Machine Integer Operands") {
+    using BI = mtmath::immut::BigInt;
+    auto big = BI{"340282366920938463463374607431768211297"};
+    CHECK_EQ(big + 5, big + BI{5});
+    CHECK_EQ(big - 5u, big - BI{5});
+    CHECK_EQ(big * -7, big * BI{-7});
+    CHECK_EQ(big / uint64_t{18446744073709551615u}, big / BI{"18446744073709551615"});
+    CHECK_EQ(big % 1000, BI{297});
+    CHECK_EQ(-big % 1000, BI{-297});
+    CHECK_EQ(BI{-7} % 2, BI{-7} % BI{2});
+    CHECK_EQ(BI{-7} / 2, BI{-3});
+
+    // Crossing zero flips the sign
+    CHECK_EQ(BI{3} - 10, BI{-7});
+    CHECK_EQ(BI{-3} + 10, BI{7});
+    CHECK_EQ(BI{-3} + 3, BI::zero());
+    CHECK_EQ(BI::zero() - std::numeric_limits<int64_t>::min(), BI{"9223372036854775808"});
+    CHECK_EQ(BI{"18446744073709551615"} + 1, BI{"18446744073709551616"});
+    CHECK_EQ(BI{"18446744073709551616"} - 1, BI{"18446744073709551615"});
+
+    CHECK_FALSE((big / 0).is_valid());
+    CHECK_FALSE((big % 0).is_valid());
+    CHECK_FALSE((BI::invalid() + 1).is_valid());
+
+    CHECK(big > 0);
+    CHECK(-big < 0);
+    CHECK(0 < big);
+    CHECK(BI{-5} == -5);
+    CHECK(BI{-5} < -4);
+    CHECK(BI{-5} > -6);
+    CHECK(BI::zero() == 0u);
+    CHECK(big > std::numeric_limits<uint64_t>::max());
+    CHECK(-big < std::numeric_limits<int64_t>::min());
+  }
+
   TEST_CASE("Modulo") {
     std::string s = (mtmath::immut::BigInt(1485209) % mtmath::immut::BigInt("2")).to_string(16).value();
     CHECK_EQ(s, "0x1");
@@ -515,6 +994,78 @@ TEST_SUITE("immut BigInt") {
     CHECK_EQ(mtmath::immut::BigInt(1485211) % mtmath::immut::BigInt("3"), mtmath::immut::BigInt("1"));
   }
 
+  TEST_CASE("GCD") {
+    using BI = mtmath::immut::BigInt;
+    CHECK_EQ(BI::gcd(BI{48}, BI{18}), BI{6});
+    CHECK_EQ(BI::gcd(BI{-48}, BI{18}), BI{6});
+    CHECK_EQ(BI::gcd(BI{48}, BI{-18}), BI{6});
+    CHECK_EQ(BI::gcd(BI{17}, BI{5}), BI{1});
+    CHECK_EQ(BI::gcd(BI::zero(), BI{-5}), BI{5});
+    CHECK_EQ(BI::gcd(BI{5}, BI::zero()), BI{5});
+    CHECK_EQ(BI::gcd(BI::zero(), BI::zero()), BI::zero());
+    CHECK_FALSE(BI::gcd(BI::invalid(), BI{5}).is_valid());
+    CHECK_FALSE(BI::gcd(BI{5}, BI::invalid()).is_valid());
+
+    // Large enough to go through the Lehmer and half-gcd paths
+    auto pow = [](int64_t base, int exp) {
+      auto res = BI::one();
+      for (int i = 0; i < exp; ++i) {
+        res = res * BI{base};
+      }
+      return res;
+    };
+    auto common = pow(3, 3000) * pow(7, 1000);
+    auto a = common * pow(5, 3000);
+    auto b = common * pow(11, 2000) + common;
+    CHECK_EQ(BI::gcd(a, b), common);
+    CHECK_EQ(BI::gcd(b, a), common);
+    CHECK_EQ(BI::gcd(pow(2, 3000) * pow(3, 500), pow(2, 1000) * pow(3, 900)), pow(2, 1000) * pow(3, 500));
+  }
+
+  TEST_CASE("Extended GCD") {
+    using BI = mtmath::immut::BigInt;
+    auto check = [](const BI& a, const BI& b, const BI& expected) {
+      auto [g, s, t] = BI::gcdext(a, b);
+      CHECK_EQ(g, expected);
+      CHECK_EQ(s * a + t * b, g);
+    };
+    check(BI{240}, BI{46}, BI{2});
+    check(BI{46}, BI{240}, BI{2});
+    check(BI{-240}, BI{46}, BI{2});
+    check(BI{240}, BI{-46}, BI{2});
+    check(BI{17}, BI{17}, BI{17});
+    check(BI::zero(), BI{-5}, BI{5});
+    check(BI{-5}, BI::zero(), BI{5});
+    check(BI::zero(), BI::zero(), BI::zero());
+
+    auto big = BI{"340282366920938463463374607431768211297"};
+    auto common = big * big * big;
+    for (int i = 0; i < 6; ++i) {
+      common = common * common + BI{i};
+    }
+    check(common * BI{"18446744073709551629"}, common * (big + BI{2}), common);
+
+    auto [g, s, t] = BI::gcdext(BI::invalid(), BI{5});
+    CHECK_FALSE(g.is_valid());
+    CHECK_FALSE(s.is_valid());
+    CHECK_FALSE(t.is_valid());
+  }
+
+  TEST_CASE("Modular Inverse") {
+    using BI = mtmath::immut::BigInt;
+    CHECK_EQ(BI::invmod(BI{3}, BI{11}), BI{4});
+    CHECK_EQ(BI::invmod(BI{-3}, BI{11}), BI{7});
+    CHECK_EQ(BI::invmod(BI{3}, BI{-11}), BI{4});
+    CHECK_EQ(BI::invmod(BI{5}, BI{1}), BI::zero());
+    CHECK_FALSE(BI::invmod(BI{4}, BI{8}).is_valid());
+    CHECK_FALSE(BI::invmod(BI{4}, BI::zero()).is_valid());
+    CHECK_FALSE(BI::invmod(BI::invalid(), BI{7}).is_valid());
+
+    auto prime = BI{"170141183460469231731687303715884105727"};
+    auto a = BI{"98765432109876543210987654321"};
+    CHECK_EQ((BI::invmod(a, prime) * a) % prime, BI::one());
+  }
+
   TEST_CASE("Numeric Properties") {
     using BI = mtmath::immut::BigInt;
     using nl = std::numeric_limits<BI>;
@@ -552,6 +1103,80 @@ TEST_SUITE("immut BigInt") {
     CHECK_EQ(nl::denorm_min(), BI::zero());
   }
 
+  TEST_CASE("Doubles") {
+    using BI = mtmath::immut::BigInt;
+    CHECK_EQ(BI::from_double(1485209.75), BI{1485209});
+    CHECK_EQ(BI::from_double(-1485209.75), BI{-1485209});
+    CHECK_EQ(BI::from_double(0.5), BI::zero());
+    CHECK_EQ(BI::from_double(0x1p100), BI{1} << 100);
+    CHECK_FALSE(BI::from_double(std::numeric_limits<double>::infinity()).is_valid());
+    CHECK_FALSE(BI::from_double(std::numeric_limits<double>::quiet_NaN()).is_valid());
+
+    CHECK_EQ(BI{1485209}.to_double(), 1485209.0);
+    CHECK_EQ(BI{-1485209}.to_double(), -1485209.0);
+    CHECK_EQ(BI::zero().to_double(), 0.0);
+    CHECK_EQ(BI{3}.to_double(-2), 0.75);
+    // Halfway cases round to even, anything past halfway rounds up
+    CHECK_EQ(((BI{1} << 53) + 1).to_double(), 0x1p53);
+    CHECK_EQ(((BI{1} << 53) + 3).to_double(), 0x1p53 + 4);
+    CHECK_EQ(((BI{1} << 200) + (BI{1} << 147)).to_double(), 0x1p200);
+    CHECK_EQ(((BI{1} << 200) + (BI{1} << 147) + 1).to_double(), 0x1p200 + 0x1p148);
+    CHECK_EQ((BI{1} << 1024).to_double(), std::numeric_limits<double>::infinity());
+    CHECK_EQ(BI{1}.to_double(-1074), std::numeric_limits<double>::denorm_min());
+    CHECK_EQ(BI{1}.to_double(-1075), 0.0);
+    CHECK(std::isnan(BI::invalid().to_double()));
+  }
+
+  TEST_CASE("Trailing Zeros") {
+    using BI = mtmath::immut::BigInt;
+    CHECK_EQ(BI::zero().trailing_zeros(), 0);
+    CHECK_EQ(BI{1}.trailing_zeros(), 0);
+    CHECK_EQ(BI{-96}.trailing_zeros(), 5);
+    CHECK_EQ((BI{3} << 200).trailing_zeros(), 200);
+  }
+
+  TEST_CASE("Bitwise") {
+    using BI = mtmath::immut::BigInt;
+    CHECK_EQ(BI{12} & BI{10}, BI{8});
+    CHECK_EQ(BI{-12} | BI{10}, BI{-2});
+    CHECK_EQ(BI{-12} ^ BI{-10}, BI{2});
+    CHECK_EQ(~BI{41}, BI{-42});
+    CHECK(BI{-8}.test_bit(3));
+    CHECK_FALSE(BI{-8}.test_bit(2));
+    CHECK_EQ(BI{-8}.set_bit(1), BI{-6});
+    CHECK_EQ(BI{5}.set_bit(0, false), BI{4});
+    CHECK_EQ(BI{-7}.popcount(), 3);
+    CHECK_FALSE((BI{1} ^ BI::invalid()).is_valid());
+  }
+
+  TEST_CASE("Chars") {
+    using BI = mtmath::immut::BigInt;
+    char buffer[64];
+    auto value = BI{"-98765432109876543210"};
+    auto [end, ec] = mtmath::to_chars(buffer, buffer + sizeof(buffer), value);
+    REQUIRE(ec == std::errc{});
+    CHECK_EQ(std::string{buffer, end}, "-98765432109876543210");
+    CHECK_EQ(mtmath::to_chars_size(BI{255}, 16), 2);
+
+    BI parsed;
+    auto res = mtmath::from_chars(buffer, end, parsed);
+    CHECK(res.ec == std::errc{});
+    CHECK_EQ(parsed, value);
+  }
+
+  TEST_CASE("Serialization") {
+    using BI = mtmath::immut::BigInt;
+    std::array<std::byte, 64> buffer{};
+    auto value = BI{"-123456789012345678901234567890"};
+    auto written = value.serialize(buffer);
+    CHECK_EQ(written, value.serialized_size());
+    size_t consumed = 0;
+    CHECK_EQ(BI::deserialize(std::span{buffer}.first(written), &consumed), value);
+    CHECK_EQ(consumed, written);
+    // Same encoding as the mutable BigInt
+    CHECK_EQ(mtmath::BigInt::deserialize(buffer), mtmath::BigInt{"-123456789012345678901234567890"});
+  }
+
   TEST_CASE("Abs Values") {
     using BI = mtmath::immut::BigInt;
     CHECK_EQ(BI{"1234"}.abs_val(), BI{"1234"});
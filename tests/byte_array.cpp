@@ -88,6 +88,26 @@ TEST_SUITE("Byte Array") {
     CHECK_EQ(num, 0x123450089);
   }
 
+  TEST_CASE("Capacity") {
+    auto ba = mtmath::ByteArray{std::vector<uint8_t>(64, 0x5a)};
+    auto capacity = ba.capacity();
+    ba.erase(ba.begin() + 1, ba.end());
+    CHECK_EQ(ba.size(), 1);
+    CHECK_EQ(ba.capacity(), capacity);
+    ba.resize(64);
+    CHECK_EQ(ba.capacity(), capacity);
+
+    // Growing past the storage at least doubles it
+    ba.resize(65);
+    CHECK_GE(ba.capacity(), 2 * capacity);
+    ba.shrink();
+    CHECK_EQ(ba.size(), 1);
+    CHECK_EQ(ba.as<uint64_t>(), 0x5a);
+    ba.resize(0);
+    ba.simplify();
+    CHECK(ba.empty());
+  }
+
   TEST_CASE("<< operator") {
     SUBCASE("Shift Left 16") {
       auto ba = mtmath::ByteArray::from<uint64_t>(0x01020304);
@@ -187,6 +207,34 @@ TEST_SUITE("Byte Array") {
     }
   }
 
+  TEST_CASE("Shift Into") {
+    auto ba = mtmath::ByteArray{std::vector<uint8_t>{0x81, 0x42, 0x24, 0x18, 0xff, 0x01, 0x80, 0x7f, 0x3c, 0xc3}};
+    // Stale contents of the destination are overwritten
+    auto dest = mtmath::ByteArray{std::vector<uint8_t>(32, 0xee)};
+
+    ba.shift_left_into(77, dest);
+    CHECK_EQ(dest, ba << 77);
+    CHECK_EQ(dest.size(), 20);
+    // Right shifts leave the emptied top byte for the caller to trim
+    dest.shift_right_into(77, dest);
+    CHECK_EQ(dest.size(), 11);
+    dest.simplify();
+    CHECK_EQ(dest, ba);
+
+    ba.shift_right_into(13, dest);
+    CHECK_EQ(dest, ba >> 13);
+    CHECK_EQ(dest.as<uint64_t>(), 0x19e3fc000ff8c122ULL);
+    ba.shift_right_into(80, dest);
+    CHECK(dest.empty());
+
+    // Whole words and a funnelled bit
+    auto words = mtmath::ByteArray::from<uint64_t>(0x8000000000000001ULL);
+    CHECK_EQ((words << 1).as<uint64_t>(), 0x2);
+    CHECK_EQ((words << 1).size(), 9);
+    CHECK_EQ((words << 1).at(8), 0x1);
+    CHECK_EQ(((words << 64) >> 64), words);
+  }
+
   TEST_CASE("Comparison") {
     CHECK_EQ(mtmath::ByteArray::from<uint64_t>(0x30), mtmath::ByteArray::from<uint64_t>(0x30));
     CHECK_NE(mtmath::ByteArray::from<uint64_t>(0x30), mtmath::ByteArray::from<uint64_t>(0x1030));
@@ -195,5 +243,47 @@ TEST_SUITE("Byte Array") {
     CHECK_EQ(mtmath::ByteArray::from<uint64_t>(0x1030) <=> mtmath::ByteArray::from<uint64_t>(0x30), std::strong_ordering::greater);
     CHECK_EQ(mtmath::ByteArray::from<uint64_t>(0x30) <=> mtmath::ByteArray::from<uint64_t>(0x31), std::strong_ordering::less);
     CHECK_EQ(mtmath::ByteArray::from<uint64_t>(0x31) <=> mtmath::ByteArray::from<uint64_t>(0x30), std::strong_ordering::greater);
+    // Most significant byte first, ignoring leading zero bytes
+    CHECK_EQ(mtmath::ByteArray{{0x01, 0x02}} <=> mtmath::ByteArray{{0x02, 0x01}}, std::strong_ordering::greater);
+    CHECK_EQ(mtmath::ByteArray{{0x30, 0x00, 0x00}}, mtmath::ByteArray::from<uint64_t>(0x30));
+  }
+
+  TEST_CASE("SIMD Levels") {
+    auto original = mtmath::ByteArray::simd_level();
+    // Long enough for every vector width plus a ragged tail
+    std::vector<uint8_t> a(203), b(150);
+    for (size_t i = 0; i < a.size(); ++i) {
+      a[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+      b[i] = static_cast<uint8_t>(i * 91 + 5);
+    }
+    for (auto level : {mtmath::SimdLevel::SCALAR, mtmath::SimdLevel::SSE2, mtmath::SimdLevel::AVX2, mtmath::SimdLevel::AVX512}) {
+      CAPTURE(static_cast<int>(mtmath::ByteArray::set_simd_level(level)));
+      auto left = mtmath::ByteArray{a};
+      auto andRes = left & b;
+      auto orRes = left | b;
+      auto xorRes = left ^ b;
+      REQUIRE_EQ(andRes.size(), b.size());
+      REQUIRE_EQ(orRes.size(), a.size());
+      for (size_t i = 0; i < a.size(); ++i) {
+        auto right = i < b.size() ? b[i] : 0;
+        CHECK_EQ(orRes[i], a[i] | right);
+        CHECK_EQ(xorRes[i], a[i] ^ right);
+        if (i < b.size()) {
+          CHECK_EQ(andRes[i], a[i] & right);
+        }
+      }
+
+      // Differences in the low bytes are only found once the high ones match
+      auto bumped = a;
+      bumped[3] += 1;
+      CHECK_LT(left, mtmath::ByteArray{bumped});
+      bumped[200] -= 1;
+      CHECK_GT(left, mtmath::ByteArray{bumped});
+      CHECK_EQ(left, mtmath::ByteArray{a});
+      CHECK((left ^ a).empty());
+    }
+    mtmath::ByteArray::set_simd_level(original);
   }
 }
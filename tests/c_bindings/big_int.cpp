@@ -1,6 +1,8 @@
 #include "../doctest.h"
 
 #include "mtmath_c.h"
+#include <cstdlib>
+#include <cstring>
 
 TEST_SUITE("C Bindings - Big Int") {
   TEST_CASE("Can initialize") {
@@ -115,6 +117,30 @@ TEST_SUITE("C Bindings - Big Int") {
     CHECK_EQ(big_int_ll(&right), 32);
   }
 
+  TEST_CASE("Leading Zero Bytes") {
+    // -300 padded with zero bytes, as C code may leave it
+    unsigned char bytes[] = {0x2c, 0x01, 0x00, 0x00};
+    MtMath_BigInt padded;
+    padded.flags = 1;
+    padded.digits.len = sizeof(bytes);
+    padded.digits.bytes = bytes;
+
+    MtMath_BigInt left;
+    init_big_int(&left);
+    set_big_int_to_int(-300, &left);
+
+    MtMath_BigInt out;
+    init_big_int(&out);
+
+    char buffer[128];
+    sub_big_int(&left, &padded, &out);
+    CHECK_EQ(big_int_ll(&out), 0);
+    div_big_int(&left, &padded, &out);
+    CHECK_EQ(big_int_ll(&out), 1);
+    big_int_str_rdx(&padded, buffer, 128, 16);
+    CHECK_EQ(strcmp(buffer, "-0x12c"), 0);
+  }
+
   TEST_CASE("From String Safe") {
     auto str = "12345";
 
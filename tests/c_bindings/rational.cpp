@@ -0,0 +1,23 @@
+#include "../doctest.h"
+
+#include "mtmath_c.h"
+#include <cstdlib>
+#include <cstring>
+
+TEST_SUITE("C Bindings - Rational") {
+  TEST_CASE("Can Parse") {
+    MtMath_Rational ra;
+    init_rational(&ra);
+
+    REQUIRE(set_rational_from_str("-12.5e-1", &ra));
+    CHECK_EQ(big_int_ll(&ra.numerator), -5);
+    CHECK_EQ(big_int_ll(&ra.denominator), 4);
+
+    REQUIRE(set_rational_from_str_safe("6/8 trailing", 3, &ra));
+    CHECK_EQ(big_int_ll(&ra.numerator), 3);
+    CHECK_EQ(big_int_ll(&ra.denominator), 4);
+
+    CHECK_FALSE(set_rational_from_str("abc", &ra));
+    CHECK_FALSE(set_rational_from_str(nullptr, &ra));
+  }
+}
@@ -0,0 +1,93 @@
+#include "impl/column_store.h"
+#include "doctest.h"
+#include <filesystem>
+#include <fstream>
+
+TEST_SUITE("Column Store") {
+  using BI = mtmath::BigInt;
+  using Rational = mtmath::Rational;
+
+  static std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+  }
+
+  TEST_CASE("BigInt columns") {
+    auto path = temp_path("mtmath_big_int_column.bin");
+    auto writer = mtmath::ColumnWriter{mtmath::ColumnKind::BIG_INT};
+    writer.push_back(BI{42});
+    writer.push_back(BI{-1} << 200);
+    writer.push_back(BI::zero());
+    writer.push_back(BI::invalid());
+    CHECK_EQ(writer.size(), 4);
+    CHECK_THROWS_AS(writer.push_back(Rational{1, 2}), std::invalid_argument);
+    REQUIRE(writer.write(path));
+
+    auto column = mtmath::MappedColumn::open(path);
+    REQUIRE(column.has_value());
+    CHECK_EQ(column->kind(), mtmath::ColumnKind::BIG_INT);
+    REQUIRE_EQ(column->size(), 4);
+    CHECK_EQ(BI{*column->big_int(0)}, BI{42});
+    auto view = column->big_int(1);
+    REQUIRE(view.has_value());
+    CHECK(view->is_negative());
+    CHECK_EQ(view->magnitude().size(), 26);
+    CHECK_EQ(BI{*view}, BI{-1} << 200);
+    CHECK(column->big_int(2)->is_zero());
+    CHECK_FALSE(column->big_int(3)->is_valid());
+    CHECK_FALSE(column->rational(0).has_value());
+    CHECK_FALSE(column->big_int(4).has_value());
+
+    // Moving keeps the views' memory mapped
+    auto moved = std::move(*column);
+    CHECK_EQ(BI{*moved.big_int(0)}, BI{42});
+    std::filesystem::remove(path);
+  }
+
+  TEST_CASE("Rational columns") {
+    auto path = temp_path("mtmath_rational_column.bin");
+    auto writer = mtmath::ColumnWriter{mtmath::ColumnKind::RATIONAL};
+    for (int i = 1; i <= 100; ++i) {
+      writer.push_back(Rational{i, 7});
+    }
+    REQUIRE(writer.write(path));
+
+    auto column = mtmath::MappedColumn::open(path);
+    REQUIRE(column.has_value());
+    REQUIRE_EQ(column->size(), 100);
+    auto sum = Rational{};
+    for (size_t i = 0; i < column->size(); ++i) {
+      sum += Rational{*column->rational(i)};
+    }
+    CHECK_EQ(sum, Rational{5050, 7});
+    CHECK_EQ(Rational{*column->rational(6)}, Rational{1});
+    CHECK_FALSE(column->rational(100).has_value());
+    std::filesystem::remove(path);
+  }
+
+  TEST_CASE("Malformed files") {
+    auto path = temp_path("mtmath_bad_column.bin");
+    CHECK_FALSE(mtmath::MappedColumn::open(path + ".missing").has_value());
+
+    auto writer = mtmath::ColumnWriter{mtmath::ColumnKind::BIG_INT};
+    writer.push_back(BI{12345});
+    REQUIRE(writer.write(path));
+    auto size = std::filesystem::file_size(path);
+
+    // Cut into the index
+    std::filesystem::resize_file(path, 30);
+    CHECK_FALSE(mtmath::MappedColumn::open(path).has_value());
+
+    // Index intact but the value is cut short
+    REQUIRE(writer.write(path));
+    std::filesystem::resize_file(path, size - 1);
+    CHECK_FALSE(mtmath::MappedColumn::open(path).has_value());
+
+    // Not a column file
+    {
+      auto out = std::ofstream{path, std::ios::binary | std::ios::trunc};
+      out << "definitely not a column file";
+    }
+    CHECK_FALSE(mtmath::MappedColumn::open(path).has_value());
+    std::filesystem::remove(path);
+  }
+}
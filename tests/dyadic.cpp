@@ -0,0 +1,68 @@
+#include "impl/dyadic.h"
+#include "doctest.h"
+#include <limits>
+#include <sstream>
+
+TEST_SUITE("Dyadic") {
+  using BI = mtmath::BigInt;
+  using Rational = mtmath::Rational;
+  using mtmath::Dyadic;
+
+  TEST_CASE("Normalizes") {
+    auto d = Dyadic{BI{48}, -6};
+    CHECK_EQ(d.mantissa(), BI{3});
+    CHECK_EQ(d.exponent(), -2);
+    CHECK_EQ(Dyadic{BI{0}, 12}.exponent(), 0);
+    CHECK_EQ(Dyadic{BI{48}, -6}, Dyadic{BI{3}, -2});
+
+    std::stringstream ss;
+    ss << Dyadic{BI{-40}};
+    CHECK_EQ(ss.str(), "-5*2^3");
+  }
+
+  TEST_CASE("Doubles") {
+    CHECK_EQ(Dyadic::from_double(0.75), Dyadic{BI{3}, -2});
+    CHECK_EQ(Dyadic::from_double(-0x1p100), Dyadic{BI{-1}, 100});
+    CHECK_EQ(Dyadic::from_double(0.0), Dyadic{});
+    CHECK_FALSE(Dyadic::from_double(std::numeric_limits<double>::infinity()).is_valid());
+    CHECK_EQ(Dyadic::from_double(0.1).to_double(), 0.1);
+    CHECK_EQ(Dyadic{BI{1}, -1074}.to_double(), std::numeric_limits<double>::denorm_min());
+  }
+
+  TEST_CASE("Rationals") {
+    CHECK_EQ(Dyadic{BI{-3}, -4}.to_rational(), Rational{-3, 16});
+    CHECK_EQ(Dyadic{BI{5}, 3}.to_rational(), Rational{40});
+    CHECK_EQ(Dyadic::from_rational(Rational{6, 64}), Dyadic{BI{3}, -5});
+    CHECK_EQ(Dyadic::from_rational(Rational{7}), Dyadic{BI{7}});
+    CHECK_FALSE(Dyadic::from_rational(Rational{1, 3}).has_value());
+    CHECK_FALSE(Dyadic::from_rational(std::numeric_limits<Rational>::infinity()).has_value());
+    CHECK(Dyadic{}.to_rational() == Rational{0});
+  }
+
+  TEST_CASE("Arithmetic") {
+    auto a = Dyadic{BI{3}, -2};
+    auto b = Dyadic{BI{5}, -3};
+    CHECK_EQ(a + b, Dyadic{BI{11}, -3});
+    CHECK_EQ(a - b, Dyadic{BI{1}, -3});
+    CHECK_EQ(a * b, Dyadic{BI{15}, -5});
+    // Odd mantissas at the same exponent sum to an even one, which is normalized away
+    CHECK_EQ(a + a, Dyadic{BI{3}, -1});
+    CHECK_EQ(a - a, Dyadic{});
+    CHECK_EQ(-a + Dyadic{}, Dyadic{BI{-3}, -2});
+    CHECK_EQ(a.ldexp(10), Dyadic{BI{3}, 8});
+    CHECK_EQ((a * b).to_rational(), a.to_rational() * b.to_rational());
+    CHECK_EQ((a + Dyadic{BI{1}, 200}).to_rational(), a.to_rational() + Rational{BI{1} << 200});
+  }
+
+  TEST_CASE("Compare") {
+    CHECK(Dyadic{BI{3}, -2} < Dyadic{BI{1}});
+    CHECK(Dyadic{BI{3}, -2} > Dyadic{BI{5}, -3});
+    CHECK(Dyadic{BI{-3}, -2} < Dyadic{BI{-5}, -3});
+    CHECK(Dyadic{BI{-1}, 100} < Dyadic{BI{1}, -100});
+    CHECK(Dyadic{BI{1}, 100} > Dyadic{BI{-1}, -100});
+    CHECK(Dyadic{} < Dyadic{BI{1}, -100});
+    CHECK(Dyadic{BI{255}, 0} < Dyadic{BI{1}, 8});
+    CHECK(Dyadic{BI{257}, 0} > Dyadic{BI{1}, 8});
+    CHECK_EQ(Dyadic{BI{3}, -2} <=> Dyadic{BI{6}, -3}, std::strong_ordering::equal);
+  }
+}
@@ -0,0 +1,68 @@
+#include "impl/hybrid_rational.h"
+#include "doctest.h"
+#include <sstream>
+
+TEST_SUITE("Hybrid Rational") {
+  using Rational = mtmath::HybridRational;
+  constexpr auto i64max = std::numeric_limits<int64_t>::max();
+
+  TEST_CASE("Constructor") {
+    std::stringstream ss;
+    ss << Rational{6, -4};
+    CHECK_EQ(ss.str(), "-3/2");
+    CHECK(Rational{6, -4}.is_small());
+    CHECK_EQ(Rational{}, Rational{0, 1});
+    CHECK(Rational{1, 0}.is_pos_infinity());
+    CHECK(Rational{-5, 0}.is_neg_infinity());
+    CHECK(Rational{0, 0}.is_nan());
+
+    // INT64_MIN is kept out of the small form so it can always be negated
+    auto min = Rational{std::numeric_limits<int64_t>::min()};
+    CHECK_FALSE(min.is_small());
+    CHECK(Rational{std::numeric_limits<int64_t>::min(), 2}.is_small());
+  }
+
+  TEST_CASE("Arithmetic") {
+    CHECK_EQ(Rational{1, 3} + Rational{1, 3}, Rational{2, 3});
+    CHECK_EQ(Rational{2, 3} + Rational{5, 6}, Rational{3, 2});
+    CHECK_EQ(Rational{3, 2} - Rational{5, 6}, Rational{2, 3});
+    CHECK_EQ(Rational{5, 7} * Rational{3, 5}, Rational{3, 7});
+    CHECK_EQ(Rational{5, 7} / Rational{-5, 3}, Rational{-3, 7});
+    CHECK_EQ(Rational{1, 6} - Rational{1, 6}, Rational{0});
+
+    std::stringstream ss;
+    ss << Rational{1, 4} + Rational{1, 4};
+    CHECK_EQ(ss.str(), "1/2");
+  }
+
+  TEST_CASE("Promotes and demotes") {
+    auto big = Rational{i64max} + Rational{i64max};
+    CHECK_FALSE(big.is_small());
+    CHECK_EQ(big.numerator(), mtmath::BigInt{"18446744073709551614"});
+    CHECK_EQ(big.denominator(), mtmath::BigInt{1});
+
+    auto product = Rational{i64max, 3} * Rational{i64max, 5};
+    CHECK_FALSE(product.is_small());
+    CHECK_EQ(product.to_rational(), mtmath::Rational{mtmath::BigInt{i64max}, 3} * mtmath::Rational{mtmath::BigInt{i64max}, 5});
+
+    auto back = big - Rational{i64max};
+    CHECK(back.is_small());
+    CHECK_EQ(back, Rational{i64max});
+
+    auto shrunk = product / Rational{i64max};
+    CHECK(shrunk.is_small());
+    CHECK_EQ(shrunk, Rational{i64max, 15});
+
+    CHECK(big > Rational{i64max});
+    CHECK(-big < Rational{-i64max});
+  }
+
+  TEST_CASE("Special Values") {
+    auto inf = Rational{1, 0};
+    CHECK((inf + Rational{1, 2}).is_pos_infinity());
+    CHECK((inf - inf).is_nan());
+    CHECK((Rational{1, 2} / Rational{0}).is_pos_infinity());
+    CHECK((Rational{-1, 2} / Rational{0}).is_neg_infinity());
+    CHECK_EQ(Rational{1, 2} / inf, Rational{0});
+  }
+}
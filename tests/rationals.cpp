@@ -1,5 +1,6 @@
 #include "impl/rational.h"
 #include "doctest.h"
+#include <array>
 #include <sstream>
 
 TEST_SUITE("Rational Base") {
@@ -124,10 +125,34 @@ TEST_SUITE("Rational Base") {
     CHECK_FALSE(half < third);
   }
 
+  TEST_CASE("simplify") {
+    using Rational = mtmath::RationalBase<int64_t>;
+    std::stringstream ss;
+    ss << Rational{6, 3};
+    CHECK_EQ(ss.str(), "2/1");
+    ss.str("");
+    ss << Rational{-12, 8};
+    CHECK_EQ(ss.str(), "-3/2");
+    ss.str("");
+    ss << Rational{12, -8};
+    CHECK_EQ(ss.str(), "-3/2");
+  }
+
   TEST_CASE("sum rationals") {
     using Rational = mtmath::RationalBase<int64_t>;
     CHECK_EQ(Rational{1, 3} + Rational{1, 3}, Rational{2, 3});
     CHECK_EQ(Rational{2, 3} + Rational{5, 6}, Rational{3, 2});
+
+    // Results come back in lowest terms
+    std::stringstream ss;
+    ss << Rational{1, 4} + Rational{1, 4};
+    CHECK_EQ(ss.str(), "1/2");
+    ss.str("");
+    ss << Rational{7, 12} + Rational{-1, 12};
+    CHECK_EQ(ss.str(), "1/2");
+    ss.str("");
+    ss << Rational{1, 6} + Rational{-1, 6};
+    CHECK_EQ(ss.str(), "0/1");
   }
 
   TEST_CASE("sub rationals") {
@@ -140,6 +165,13 @@ TEST_SUITE("Rational Base") {
     using Rational = mtmath::RationalBase<int64_t>;
     CHECK_EQ(Rational{2, 7} * Rational{3, 5}, Rational{6, 35});
     CHECK_EQ(Rational{5, 7} * Rational{3, 5}, Rational{3, 7});
+
+    std::stringstream ss;
+    ss << Rational{-4, 9} * Rational{3, 8};
+    CHECK_EQ(ss.str(), "-1/6");
+    ss.str("");
+    ss << Rational{0, 9} * Rational{3, 8};
+    CHECK_EQ(ss.str(), "0/1");
   }
 
   TEST_CASE("div rationals") {
@@ -148,6 +180,22 @@ TEST_SUITE("Rational Base") {
     CHECK_EQ(Rational{5, 7} / Rational{5, 3}, Rational{3, 7});
   }
 
+  TEST_CASE("integer operands") {
+    using Rational = mtmath::RationalBase<int64_t>;
+    CHECK_EQ(Rational{2, 7} + 3, Rational{23, 7});
+    CHECK_EQ(Rational{2, 7} - 1, Rational{-5, 7});
+    CHECK_EQ(Rational{2, 7} * 14, Rational{4});
+    CHECK_EQ(Rational{2, 21} * -6, Rational{-4, 7});
+    CHECK_EQ(Rational{2, 7} * 0, Rational{0});
+    CHECK_EQ(Rational{4, 7} / 6, Rational{2, 21});
+    CHECK_EQ(Rational{4, 7} / -2, Rational{-2, 7});
+    CHECK((Rational{4, 7} / 0).is_pos_infinity());
+    CHECK((std::numeric_limits<Rational>::infinity() + 3).is_pos_infinity());
+    CHECK((Rational{2, 7} + -std::numeric_limits<Rational>::infinity()).is_neg_infinity());
+    CHECK((std::numeric_limits<Rational>::infinity() * -3).is_neg_infinity());
+    CHECK((std::numeric_limits<Rational>::infinity() * 0).is_nan());
+  }
+
   TEST_CASE("Special Values") {
     using Rational = mtmath::RationalBase<int64_t>;
     auto inf = std::numeric_limits<Rational>::infinity();
@@ -436,10 +484,60 @@ TEST_SUITE("Rational") {
     CHECK_EQ(ss.str(), "1/3");
   }
 
+  TEST_CASE("compare large") {
+    using Rational = mtmath::Rational;
+    using BI = mtmath::BigInt;
+    auto big = BI{"340282366920938463463374607431768211297"};
+    auto other = BI{"18446744073709551629"};
+    // Differ far past double precision
+    auto a = Rational{big * other + BI{1}, big * BI{"18446744073709551631"}};
+    auto b = Rational{big * other, big * BI{"18446744073709551631"} + BI{1}};
+    CHECK(a > b);
+    CHECK(b < a);
+    CHECK(-a < -b);
+    CHECK_EQ(a <=> a, std::strong_ordering::equal);
+    // Different magnitudes and signs
+    CHECK(Rational{big, other} > Rational{other, big});
+    CHECK(Rational{-big, other} < Rational{other, big});
+    CHECK(Rational{-big, other} < Rational{-other, big});
+    CHECK(Rational{BI{0}, other} < Rational{other, big});
+    CHECK(Rational{big, other} < std::numeric_limits<Rational>::infinity());
+    // Denominator which rounds up to a power of two as a double
+    CHECK(Rational{BI{9}, BI{"2067756122010323180"}} > Rational{BI{31}, BI{"9223372036854775806"}});
+  }
+
+  TEST_CASE("simplify") {
+    using Rational = mtmath::Rational;
+    std::stringstream ss;
+    ss << Rational{6, 3};
+    CHECK_EQ(ss.str(), "2/1");
+    ss.str("");
+    ss << Rational{-12, 8};
+    CHECK_EQ(ss.str(), "-3/2");
+    ss.str("");
+    ss << Rational{12, -8};
+    CHECK_EQ(ss.str(), "-3/2");
+    auto big = mtmath::BigInt{"340282366920938463463374607431768211297"};
+    ss.str("");
+    ss << Rational{big * mtmath::BigInt{6}, big * mtmath::BigInt{-4}};
+    CHECK_EQ(ss.str(), "-3/2");
+  }
+
   TEST_CASE("sum rationals") {
     using Rational = mtmath::Rational;
     CHECK_EQ(Rational{1, 3} + Rational{1, 3}, Rational{2, 3});
     CHECK_EQ(Rational{2, 3} + Rational{5, 6}, Rational{3, 2});
+
+    // Results come back in lowest terms
+    std::stringstream ss;
+    ss << Rational{1, 4} + Rational{1, 4};
+    CHECK_EQ(ss.str(), "1/2");
+    ss.str("");
+    ss << Rational{7, 12} + Rational{-1, 12};
+    CHECK_EQ(ss.str(), "1/2");
+    ss.str("");
+    ss << Rational{1, 6} + Rational{-1, 6};
+    CHECK_EQ(ss.str(), "0/1");
   }
 
   TEST_CASE("sub rationals") {
@@ -452,6 +550,13 @@ TEST_SUITE("Rational") {
     using Rational = mtmath::Rational;
     CHECK_EQ(Rational{2, 7} * Rational{3, 5}, Rational{6, 35});
     CHECK_EQ(Rational{5, 7} * Rational{3, 5}, Rational{3, 7});
+
+    std::stringstream ss;
+    ss << Rational{-4, 9} * Rational{3, 8};
+    CHECK_EQ(ss.str(), "-1/6");
+    ss.str("");
+    ss << Rational{0, 9} * Rational{3, 8};
+    CHECK_EQ(ss.str(), "0/1");
   }
 
   TEST_CASE("div rationals") {
@@ -460,6 +565,175 @@ TEST_SUITE("Rational") {
     CHECK_EQ(Rational{5, 7} / Rational{5, 3}, Rational{3, 7});
   }
 
+  TEST_CASE("integer operands") {
+    using Rational = mtmath::Rational;
+    using BI = mtmath::BigInt;
+    CHECK_EQ(Rational{2, 7} + 3, Rational{23, 7});
+    CHECK_EQ(Rational{2, 7} - 1, Rational{-5, 7});
+    CHECK_EQ(Rational{2, 7} * 14, Rational{4});
+    CHECK_EQ(Rational{2, 21} * -6, Rational{-4, 7});
+    CHECK_EQ(Rational{2, 7} * 0, Rational{0});
+    CHECK_EQ(Rational{4, 7} / 6, Rational{2, 21});
+    CHECK_EQ(Rational{4, 7} / -2, Rational{-2, 7});
+    CHECK((Rational{4, 7} / 0).is_pos_infinity());
+    CHECK((std::numeric_limits<Rational>::infinity() + 3).is_pos_infinity());
+    CHECK((Rational{2, 7} + -std::numeric_limits<Rational>::infinity()).is_neg_infinity());
+    CHECK((std::numeric_limits<Rational>::infinity() * -3).is_neg_infinity());
+    CHECK((std::numeric_limits<Rational>::infinity() * 0).is_nan());
+    CHECK_EQ(Rational{BI{1}, BI{3}} + BI{"18446744073709551616"}, Rational{BI{"55340232221128654849"}, BI{3}});
+    CHECK_EQ(Rational{BI{5}, BI{"18446744073709551616"}} * BI{"36893488147419103232"}, Rational{10});
+    CHECK_EQ(Rational{BI{5}, BI{3}} / BI{"-36893488147419103232"}, Rational{BI{-5}, BI{"110680464442257309696"}});
+    CHECK_EQ(Rational{1, 3} - std::numeric_limits<int64_t>::min(), Rational{BI{"27670116110564327425"}, BI{3}});
+    CHECK_EQ(Rational{1, 3} * std::numeric_limits<uint64_t>::max(), Rational{BI{"6148914691236517205"}});
+  }
+  TEST_CASE("doubles") {
+    using Rational = mtmath::Rational;
+    using BI = mtmath::BigInt;
+    CHECK_EQ(Rational::from_double(0.75), Rational{3, 4});
+    CHECK_EQ(Rational::from_double(-0.1), Rational{BI{-3602879701896397}, BI{1} << 55});
+    CHECK_EQ(Rational::from_double(0x1p80), Rational{BI{1} << 80});
+    CHECK_EQ(Rational::from_double(0.0), Rational{0});
+    CHECK_EQ(Rational::from_double(std::numeric_limits<double>::denorm_min()), Rational{BI{1}, BI{1} << 1074});
+    CHECK(Rational::from_double(-std::numeric_limits<double>::infinity()).is_neg_infinity());
+    CHECK(Rational::from_double(std::numeric_limits<double>::quiet_NaN()).is_nan());
+
+    CHECK_EQ(Rational{1, 3}.to_double(), 1.0 / 3.0);
+    CHECK_EQ(Rational{-2, 7}.to_double(), -2.0 / 7.0);
+    CHECK_EQ(Rational::from_double(0.1).to_double(), 0.1);
+    CHECK_EQ(Rational{BI{1}, BI{3} << 1070}.to_double(), 0x1.5555555555555p-1072);
+    CHECK_EQ(Rational{BI{1} << 1100, BI{3}}.to_double(), std::numeric_limits<double>::infinity());
+    CHECK(std::isnan(std::numeric_limits<Rational>::quiet_NaN().to_double()));
+  }
+
+
+  TEST_CASE("decimal strings") {
+    using Rational = mtmath::Rational;
+    using BI = mtmath::BigInt;
+    using Mode = mtmath::DecimalRounding;
+
+    CHECK_EQ(Rational{2, 3}.to_decimal_string(4), "0.6667");
+    CHECK_EQ(Rational{2, 3}.to_decimal_string(4, Mode::DOWN), "0.6666");
+    CHECK_EQ(Rational{-2, 3}.to_decimal_string(2, Mode::FLOOR), "-0.67");
+    CHECK_EQ(Rational{-2, 3}.to_decimal_string(2, Mode::CEILING), "-0.66");
+    CHECK_EQ(Rational{1, 8}.to_decimal_string(2), "0.12");
+    CHECK_EQ(Rational{3, 8}.to_decimal_string(2), "0.38");
+    CHECK_EQ(Rational{1, 8}.to_decimal_string(2, Mode::HALF_UP), "0.13");
+    CHECK_EQ(Rational{5, 2}.to_decimal_string(0), "2");
+    CHECK_EQ(Rational{7, 2}.to_decimal_string(0), "4");
+    CHECK_EQ(Rational{22, 7}.to_decimal_string(0), "3");
+    CHECK_EQ(Rational{-1, 1000}.to_decimal_string(2), "0.00");
+    CHECK_EQ(Rational{-1, 1000}.to_decimal_string(2, Mode::UP), "-0.01");
+    // Carries through the nines into the integer part
+    CHECK_EQ(Rational{19999, 2000}.to_decimal_string(3), "10.000");
+    CHECK_EQ(Rational{1, 4}.to_decimal_string(5), "0.25000");
+
+    // Spans several 18 digit chunks
+    auto third = Rational{1, 3}.to_decimal_string(50);
+    CHECK_EQ(third, "0." + std::string(49, '3') + "3");
+    CHECK_EQ(Rational{BI{1}, BI{1} << 64}.to_decimal_string(64), "0.0000000000000000000542101086242752217003726400434970855712890625");
+    CHECK_EQ(std::numeric_limits<Rational>::quiet_NaN().to_decimal_string(2), "NaN");
+    CHECK_EQ((-std::numeric_limits<Rational>::infinity()).to_decimal_string(2), "-inf");
+  }
+
+  TEST_CASE("parse") {
+    using Rational = mtmath::Rational;
+    using BI = mtmath::BigInt;
+
+    CHECK_EQ(Rational::parse("3/8"), Rational{3, 8});
+    CHECK_EQ(Rational::parse("-6/16"), Rational{-3, 8});
+    CHECK_EQ(Rational::parse("42"), Rational{42});
+    CHECK_EQ(Rational::parse("+12.50"), Rational{25, 2});
+    CHECK_EQ(Rational::parse("-0.125"), Rational{-1, 8});
+    CHECK_EQ(Rational::parse(".5"), Rational{1, 2});
+    CHECK_EQ(Rational::parse("5."), Rational{5});
+    CHECK_EQ(Rational::parse("1.5E3"), Rational{1500});
+    CHECK_EQ(Rational::parse("123.4567e-12"), Rational{BI{1234567}, BI{"10000000000000000"}});
+    CHECK_EQ(Rational::parse("2.4e-1"), Rational{6, 25});
+    CHECK_EQ(Rational::parse("-0.0"), Rational{0});
+    CHECK_EQ(Rational::parse("1/0"), std::numeric_limits<Rational>::infinity());
+    CHECK_EQ(Rational::parse("123456789012345678901234567890.5"), Rational{BI{"246913578024691357802469135781"}, BI{2}});
+    CHECK(Rational::parse("NaN")->is_nan());
+    CHECK(Rational::parse("-inf")->is_neg_infinity());
+    CHECK(Rational::parse("Infinity")->is_pos_infinity());
+
+    // Reduced by 2s and 5s alone, so the parts are still in lowest terms
+    auto parsed = Rational::parse("0.000375").value();
+    CHECK_EQ(parsed.numerator(), BI{3});
+    CHECK_EQ(parsed.denominator(), BI{8000});
+    // Fives are stripped a word at a time, with the last chunk read off the remainder
+    parsed = Rational::parse("867361737988403547205962240695953369140625e-70").value();
+    CHECK_EQ(parsed.numerator(), BI{1});
+    CHECK_EQ(parsed.denominator(), BI{"11529215046068469760000000000"});
+    parsed = Rational::parse("2793967723846435546875e-29").value();
+    CHECK_EQ(parsed.numerator(), BI{15});
+    CHECK_EQ(parsed.denominator(), BI{1} << 29);
+    CHECK_EQ(Rational::parse(Rational{-11, 6}.to_decimal_string(30)), Rational{BI{"-1833333333333333333333333333333"}, BI{"1000000000000000000000000000000"}});
+
+    CHECK_FALSE(Rational::parse("").has_value());
+    CHECK_FALSE(Rational::parse("-").has_value());
+    CHECK_FALSE(Rational::parse(".").has_value());
+    CHECK_FALSE(Rational::parse("1e").has_value());
+    CHECK_FALSE(Rational::parse("1.2.3").has_value());
+    CHECK_FALSE(Rational::parse("3/").has_value());
+    CHECK_FALSE(Rational::parse("3/-8").has_value());
+    CHECK_FALSE(Rational::parse("1.5/2").has_value());
+    CHECK_FALSE(Rational::parse("12 ").has_value());
+    CHECK_FALSE(Rational::parse("0x10").has_value());
+    // Exponents are bounded so short text cannot expand into a huge power of ten
+    CHECK_FALSE(Rational::parse("1e100000000").has_value());
+    CHECK_FALSE(Rational::parse("1e-100001").has_value());
+    CHECK_EQ(Rational::parse("1e-100000")->denominator().bit_length(), 332193);
+  }
+
+  TEST_CASE("repeating decimal strings") {
+    using Rational = mtmath::Rational;
+    using BI = mtmath::BigInt;
+
+    CHECK_EQ(Rational{1, 3}.to_repeating_decimal_string(), "0.(3)");
+    CHECK_EQ(Rational{1, 6}.to_repeating_decimal_string(), "0.1(6)");
+    CHECK_EQ(Rational{-11, 6}.to_repeating_decimal_string(), "-1.8(3)");
+    CHECK_EQ(Rational{1, 7}.to_repeating_decimal_string(), "0.(142857)");
+    CHECK_EQ(Rational{1, 7}.to_repeating_decimal_string(5), std::nullopt);
+    CHECK_EQ(Rational{7, 12}.to_repeating_decimal_string(), "0.58(3)");
+    CHECK_EQ(Rational{1, 8}.to_repeating_decimal_string(), "0.125");
+    CHECK_EQ(Rational{42}.to_repeating_decimal_string(), "42");
+    CHECK_EQ(Rational{BI{1}, BI{5} * BI{5} * BI{5} * BI{2}}.to_repeating_decimal_string(), "0.004");
+    CHECK_EQ(Rational{1, 97}.to_repeating_decimal_string()->size(), 2 + 2 + 96);
+  }
+
+  TEST_CASE("serialization") {
+    using Rational = mtmath::Rational;
+    std::array<std::byte, 64> buffer{};
+    auto value = Rational{-22, 7};
+    auto written = value.serialize(buffer);
+    CHECK_EQ(written, 6);
+    CHECK_EQ(written, value.serialized_size());
+    size_t consumed = 0;
+    CHECK_EQ(Rational::deserialize(buffer, &consumed), value);
+    CHECK_EQ(consumed, written);
+    auto view = mtmath::RationalView::deserialize(buffer);
+    REQUIRE(view.has_value());
+    CHECK(view->numerator().is_negative());
+    CHECK_EQ(Rational{*view}, value);
+
+    auto nan = std::numeric_limits<Rational>::quiet_NaN();
+    nan.serialize(buffer);
+    CHECK(Rational::deserialize(buffer)->is_nan());
+    CHECK_EQ(value.serialize(std::span{buffer}.first(5)), 0);
+    CHECK_FALSE(Rational::deserialize(std::span{buffer}.first(3)).has_value());
+    // Negative denominator
+    auto written2 = mtmath::BigInt{1}.serialize(buffer);
+    mtmath::BigInt{-2}.serialize(std::span{buffer}.subspan(written2));
+    CHECK_FALSE(Rational::deserialize(buffer).has_value());
+    // Stored parts which are not in lowest terms are reduced on the way in
+    written2 = mtmath::BigInt{2}.serialize(buffer);
+    mtmath::BigInt{4}.serialize(std::span{buffer}.subspan(written2));
+    auto half = Rational::deserialize(buffer).value();
+    CHECK_EQ(half.denominator(), mtmath::BigInt{2});
+    CHECK_EQ(half + Rational{1, 2}, Rational{1});
+    CHECK_EQ(*mtmath::immut::Rational::deserialize(buffer) + mtmath::immut::Rational{1, 2}, mtmath::immut::Rational{1});
+  }
+
   TEST_CASE("Special Values") {
     using Rational = mtmath::Rational;
     auto inf = std::numeric_limits<Rational>::infinity();
@@ -748,10 +1022,56 @@ TEST_SUITE("Immut Rational") {
     CHECK_EQ(ss.str(), "1/3");
   }
 
+  TEST_CASE("compare large") {
+    using Rational = mtmath::immut::Rational;
+    using BI = mtmath::immut::BigInt;
+    auto big = BI{"340282366920938463463374607431768211297"};
+    auto other = BI{"18446744073709551629"};
+    // Differ far past double precision
+    auto a = Rational{big * other + BI{1}, big * BI{"18446744073709551631"}};
+    auto b = Rational{big * other, big * BI{"18446744073709551631"} + BI{1}};
+    CHECK(a > b);
+    CHECK(b < a);
+    CHECK(-a < -b);
+    CHECK_EQ(a <=> a, std::strong_ordering::equal);
+    // Different magnitudes and signs
+    CHECK(Rational{big, other} > Rational{other, big});
+    CHECK(Rational{-big, other} < Rational{other, big});
+    CHECK(Rational{-big, other} < Rational{-other, big});
+    CHECK(Rational{BI{0}, other} < Rational{other, big});
+    CHECK(Rational{big, other} < std::numeric_limits<Rational>::infinity());
+    // Denominator which rounds up to a power of two as a double
+    CHECK(Rational{BI{9}, BI{"2067756122010323180"}} > Rational{BI{31}, BI{"9223372036854775806"}});
+  }
+
+  TEST_CASE("simplify") {
+    using Rational = mtmath::immut::Rational;
+    std::stringstream ss;
+    ss << Rational{6, 3};
+    CHECK_EQ(ss.str(), "2/1");
+    ss.str("");
+    ss << Rational{-12, 8};
+    CHECK_EQ(ss.str(), "-3/2");
+    ss.str("");
+    ss << Rational{12, -8};
+    CHECK_EQ(ss.str(), "-3/2");
+  }
+
   TEST_CASE("sum rationals") {
     using Rational = mtmath::immut::Rational;
     CHECK_EQ(Rational{1, 3} + Rational{1, 3}, Rational{2, 3});
     CHECK_EQ(Rational{2, 3} + Rational{5, 6}, Rational{3, 2});
+
+    // Results come back in lowest terms
+    std::stringstream ss;
+    ss << Rational{1, 4} + Rational{1, 4};
+    CHECK_EQ(ss.str(), "1/2");
+    ss.str("");
+    ss << Rational{7, 12} + Rational{-1, 12};
+    CHECK_EQ(ss.str(), "1/2");
+    ss.str("");
+    ss << Rational{1, 6} + Rational{-1, 6};
+    CHECK_EQ(ss.str(), "0/1");
   }
 
   TEST_CASE("sub rationals") {
@@ -764,6 +1084,13 @@ TEST_SUITE("Immut Rational") {
     using Rational = mtmath::immut::Rational;
     CHECK_EQ(Rational{2, 7} * Rational{3, 5}, Rational{6, 35});
     CHECK_EQ(Rational{5, 7} * Rational{3, 5}, Rational{3, 7});
+
+    std::stringstream ss;
+    ss << Rational{-4, 9} * Rational{3, 8};
+    CHECK_EQ(ss.str(), "-1/6");
+    ss.str("");
+    ss << Rational{0, 9} * Rational{3, 8};
+    CHECK_EQ(ss.str(), "0/1");
   }
 
   TEST_CASE("div rationals") {
@@ -772,6 +1099,47 @@ TEST_SUITE("Immut Rational") {
     CHECK_EQ(Rational{5, 7} / Rational{5, 3}, Rational{3, 7});
   }
 
+  TEST_CASE("integer operands") {
+    using Rational = mtmath::immut::Rational;
+    using BI = mtmath::immut::BigInt;
+    CHECK_EQ(Rational{2, 7} + 3, Rational{23, 7});
+    CHECK_EQ(Rational{2, 7} - 1, Rational{-5, 7});
+    CHECK_EQ(Rational{2, 7} * 14, Rational{4});
+    CHECK_EQ(Rational{2, 21} * -6, Rational{-4, 7});
+    CHECK_EQ(Rational{2, 7} * 0, Rational{0});
+    CHECK_EQ(Rational{4, 7} / 6, Rational{2, 21});
+    CHECK_EQ(Rational{4, 7} / -2, Rational{-2, 7});
+    CHECK((Rational{4, 7} / 0).is_pos_infinity());
+    CHECK((std::numeric_limits<Rational>::infinity() + 3).is_pos_infinity());
+    CHECK((Rational{2, 7} + -std::numeric_limits<Rational>::infinity()).is_neg_infinity());
+    CHECK((std::numeric_limits<Rational>::infinity() * -3).is_neg_infinity());
+    CHECK((std::numeric_limits<Rational>::infinity() * 0).is_nan());
+    CHECK_EQ(Rational{BI{1}, BI{3}} + BI{"18446744073709551616"}, Rational{BI{"55340232221128654849"}, BI{3}});
+    CHECK_EQ(Rational{BI{5}, BI{"18446744073709551616"}} * BI{"36893488147419103232"}, Rational{10});
+    CHECK_EQ(Rational{BI{5}, BI{3}} / BI{"-36893488147419103232"}, Rational{BI{-5}, BI{"110680464442257309696"}});
+    CHECK_EQ(Rational{1, 3} - std::numeric_limits<int64_t>::min(), Rational{BI{"27670116110564327425"}, BI{3}});
+    CHECK_EQ(Rational{1, 3} * std::numeric_limits<uint64_t>::max(), Rational{BI{"6148914691236517205"}});
+  }
+  TEST_CASE("doubles") {
+    using Rational = mtmath::immut::Rational;
+    using BI = mtmath::immut::BigInt;
+    CHECK_EQ(Rational::from_double(0.75), Rational{3, 4});
+    CHECK_EQ(Rational::from_double(-0.1), Rational{BI{-3602879701896397}, BI{1} << 55});
+    CHECK_EQ(Rational::from_double(0x1p80), Rational{BI{1} << 80});
+    CHECK_EQ(Rational::from_double(0.0), Rational{0});
+    CHECK_EQ(Rational::from_double(std::numeric_limits<double>::denorm_min()), Rational{BI{1}, BI{1} << 1074});
+    CHECK(Rational::from_double(-std::numeric_limits<double>::infinity()).is_neg_infinity());
+    CHECK(Rational::from_double(std::numeric_limits<double>::quiet_NaN()).is_nan());
+
+    CHECK_EQ(Rational{1, 3}.to_double(), 1.0 / 3.0);
+    CHECK_EQ(Rational{-2, 7}.to_double(), -2.0 / 7.0);
+    CHECK_EQ(Rational::from_double(0.1).to_double(), 0.1);
+    CHECK_EQ(Rational{BI{1}, BI{3} << 1070}.to_double(), 0x1.5555555555555p-1072);
+    CHECK_EQ(Rational{BI{1} << 1100, BI{3}}.to_double(), std::numeric_limits<double>::infinity());
+    CHECK(std::isnan(std::numeric_limits<Rational>::quiet_NaN().to_double()));
+  }
+
+
   TEST_CASE("copy rationals") {
     using Rational = mtmath::immut::Rational;
     auto a = Rational{2, 3};
@@ -784,6 +1152,16 @@ TEST_SUITE("Immut Rational") {
     CHECK_EQ(b, a);
   }
 
+  TEST_CASE("serialization") {
+    using Rational = mtmath::immut::Rational;
+    std::array<std::byte, 64> buffer{};
+    auto value = Rational{-22, 7};
+    auto written = value.serialize(buffer);
+    CHECK_EQ(written, value.serialized_size());
+    CHECK_EQ(Rational::deserialize(buffer), value);
+    CHECK_EQ(mtmath::Rational::deserialize(buffer), mtmath::Rational{-22, 7});
+  }
+
   TEST_CASE("Special Values") {
     using Rational = mtmath::immut::Rational;
     auto inf = std::numeric_limits<Rational>::infinity();
@@ -942,3 +1320,80 @@ TEST_SUITE("Immut Rational") {
     CHECK_EQ(nl::denorm_min(), -nl::infinity());
   }
 }
+
+TEST_SUITE("Lazy Rational") {
+  TEST_CASE("accumulates like eager rationals") {
+    auto lazy = mtmath::LazyRational{};
+    auto eager = mtmath::Rational{};
+    for (int i = 1; i <= 40; ++i) {
+      lazy += mtmath::LazyRational{1, i};
+      eager += mtmath::Rational{1, i};
+    }
+    CHECK_EQ(lazy.numerator(), eager.numerator());
+    CHECK_EQ(lazy.denominator(), eager.denominator());
+
+    lazy *= mtmath::LazyRational{3, 7};
+    lazy /= mtmath::LazyRational{-5, 11};
+    lazy -= mtmath::LazyRational{1, 2};
+    eager *= mtmath::Rational{3, 7};
+    eager /= mtmath::Rational{-5, 11};
+    eager -= mtmath::Rational{1, 2};
+    CHECK_EQ(lazy.numerator(), eager.numerator());
+    CHECK_EQ(lazy.denominator(), eager.denominator());
+  }
+
+  TEST_CASE("integer operands") {
+    auto lazy = mtmath::LazyRational{3, 4};
+    auto eager = mtmath::Rational{3, 4};
+    lazy = (lazy * 10 + 7) / -6 - mtmath::BigInt{2};
+    eager = (eager * 10 + 7) / -6 - mtmath::BigInt{2};
+    CHECK_EQ(lazy.numerator(), eager.numerator());
+    CHECK_EQ(lazy.denominator(), eager.denominator());
+    CHECK_EQ(eager, mtmath::Rational{-53, 12});
+  }
+
+  TEST_CASE("reduces when observed") {
+    using Rational = mtmath::LazyRational;
+    auto sum = Rational{1, 4};
+    sum += Rational{1, 4};
+    sum += Rational{1, 6};
+    std::stringstream ss;
+    ss << sum;
+    CHECK_EQ(ss.str(), "2/3");
+    CHECK(Rational{2, 5} * Rational{5, 2} == Rational{1});
+    CHECK(Rational{1, 3} / Rational{-2, 3} < Rational{0});
+  }
+
+  TEST_CASE("reduces when parts grow too large") {
+    using Rational = mtmath::RationalBase<int64_t, mtmath::LazyNormalization<16>>;
+    auto acc = Rational{1};
+    for (int i = 0; i < 20; ++i) {
+      acc *= Rational{6, 5};
+      acc *= Rational{5, 6};
+    }
+    CHECK_EQ(acc, Rational{1});
+    CHECK_EQ(acc.denominator(), 1);
+  }
+
+  TEST_CASE("values larger than the threshold in lowest terms") {
+    // The reduced denominator outgrows the threshold, so reductions are spaced out by size instead
+    using Rational = mtmath::RationalBase<mtmath::BigInt, mtmath::LazyNormalization<64>>;
+    auto lazy = Rational{};
+    auto eager = mtmath::Rational{};
+    for (int i = 1; i <= 300; ++i) {
+      lazy -= Rational{-1, i};
+      eager += mtmath::Rational{1, i};
+    }
+    CHECK_GT(eager.denominator().bit_length(), 256);
+    CHECK_EQ(lazy.numerator(), eager.numerator());
+    CHECK_EQ(lazy.denominator(), eager.denominator());
+  }
+
+  TEST_CASE("special values") {
+    using Rational = mtmath::LazyRational;
+    using nl = std::numeric_limits<Rational>;
+    CHECK((Rational{1, 2} / Rational{0}).is_pos_infinity());
+    CHECK((nl::infinity() + Rational{1, 2}).is_pos_infinity());
+    CHECK((nl::infinity() - nl::infinity()).is_nan());
+  }
+}
@@ -0,0 +1,91 @@
+#include "impl/super_accumulator.h"
+#include "doctest.h"
+#include <limits>
+
+TEST_SUITE("Super Accumulator") {
+  using Rational = mtmath::Rational;
+  using BI = mtmath::BigInt;
+
+  TEST_CASE("Sums doubles exactly") {
+    auto acc = mtmath::SuperAccumulator{};
+    CHECK_EQ(acc.to_rational(), Rational{0});
+
+    // Each term is exact as a double, but a double sum would lose the small ones
+    acc += 0x1p100;
+    acc += 1.0;
+    acc += -0x1p100;
+    acc += 0.5;
+    CHECK_EQ(acc.to_rational(), Rational{3, 2});
+
+    acc -= 1.5;
+    CHECK_EQ(acc.to_rational(), Rational{0});
+
+    acc += 0.1;
+    CHECK_EQ(acc.to_rational(), Rational::from_double(0.1));
+  }
+
+  TEST_CASE("Covers the whole double range") {
+    auto acc = mtmath::SuperAccumulator{};
+    auto max = std::numeric_limits<double>::max();
+    auto tiny = std::numeric_limits<double>::denorm_min();
+    acc += max;
+    acc += max;
+    acc += tiny;
+    acc -= -tiny;
+    CHECK_EQ(acc.to_rational(), Rational::from_double(max) * 2 + Rational::from_double(tiny) * 2);
+
+    for (int i = 0; i < 1000; ++i) {
+      acc -= max;
+    }
+    CHECK_EQ(acc.to_rational(), Rational::from_double(max) * -998 + Rational::from_double(tiny) * 2);
+  }
+
+  TEST_CASE("Matches rational sums") {
+    auto acc = mtmath::SuperAccumulator{};
+    auto expected = Rational{0};
+    auto value = 1.0;
+    for (int i = 0; i < 2000; ++i) {
+      value = value * -1.37 + 0.001 * i;
+      acc += value;
+      expected += Rational::from_double(value);
+    }
+    CHECK_EQ(acc.to_rational(), expected);
+  }
+
+  TEST_CASE("Sums rationals") {
+    auto acc = mtmath::SuperAccumulator{};
+    acc += Rational{3, 8};
+    acc += Rational{BI{1}, BI{1} << 1100};
+    acc += Rational{1, 3};
+    acc += 0.25;
+    acc -= Rational{BI{1}, BI{1} << 1100};
+    CHECK_EQ(acc.to_rational(), Rational{23, 24});
+  }
+
+  TEST_CASE("Merges") {
+    auto a = mtmath::SuperAccumulator{};
+    auto b = mtmath::SuperAccumulator{};
+    a += 0.75;
+    a += Rational{1, 3};
+    b += -0x1p-1000;
+    b += Rational{1, 6};
+    a += b;
+    CHECK_EQ(a.to_rational(), Rational{5, 4} - Rational{BI{1}, BI{1} << 1000});
+
+    a.clear();
+    CHECK_EQ(a.to_rational(), Rational{0});
+  }
+
+  TEST_CASE("Special values") {
+    auto acc = mtmath::SuperAccumulator{};
+    acc += 1.0;
+    acc += std::numeric_limits<double>::infinity();
+    CHECK(acc.to_rational().is_pos_infinity());
+    acc += -std::numeric_limits<double>::infinity();
+    CHECK(acc.to_rational().is_nan());
+
+    acc.clear();
+    acc += std::numeric_limits<double>::quiet_NaN();
+    CHECK(acc.to_rational().is_nan());
+  }
+}